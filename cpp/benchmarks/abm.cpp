@@ -1,8 +1,78 @@
 #include "abm/simulation.h"
+#include "abm/step_hooks.h"
+#include "memilio/utils/mioomp.h"
 #include "memilio/utils/stl_util.h"
 #include "benchmark/benchmark.h"
 
-mio::abm::Simulation make_simulation(size_t num_persons, std::initializer_list<uint32_t> seeds)
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * How the persons move between locations.
+ */
+enum class Mobility
+{
+    Rules, ///< daily routine from the migration rules.
+    Trips, ///< daily routine from a trip list, migration rules only for infection related migration.
+};
+
+/**
+ * Configuration of an ABM benchmark.
+ */
+struct AbmBenchmarkSetup {
+    Mobility mobility;
+    size_t num_testing_schemes; ///< number of testing schemes, distributed over the location types.
+    size_t persons_per_location; ///< average number of persons assigned to each location that is not a home.
+    int num_days; ///< simulated time.
+};
+
+/**
+ * Create a daily routine of trips for each person, i.e. to school or work in the morning,
+ * to the shop in the afternoon for some persons and back home in the evening.
+ */
+void add_trips(mio::abm::World& world)
+{
+    using mio::abm::LocationType;
+    auto& rng = world.get_rng();
+    std::vector<mio::abm::Trip> trips;
+    for (auto& person : world.get_persons()) {
+        auto get_location_id = [&](LocationType type) {
+            return mio::abm::LocationId{person.get_assigned_location_index(type), type};
+        };
+        auto hour = [&](double min, double max) {
+            return mio::abm::TimePoint(0) +
+                   mio::abm::seconds(int(3600 * mio::UniformDistribution<double>::get_instance()(rng, min, max)));
+        };
+        auto home  = get_location_id(LocationType::Home);
+        auto daily = person.get_age() < mio::AgeGroup(2) ? get_location_id(LocationType::School)
+                                                         : get_location_id(LocationType::Work);
+        auto id    = person.get_person_id();
+        trips.emplace_back(id, hour(6, 9), daily, home);
+        if (mio::UniformDistribution<double>::get_instance()(rng) < 0.3) {
+            auto shop = get_location_id(LocationType::BasicsShop);
+            trips.emplace_back(id, hour(15, 17), shop, daily);
+            trips.emplace_back(id, hour(17.5, 20), home, shop);
+        }
+        else {
+            trips.emplace_back(id, hour(15, 20), home, daily);
+        }
+    }
+    //adding trips in order is much faster, they are sorted on insertion
+    std::sort(trips.begin(), trips.end(), [](auto& trip1, auto& trip2) {
+        return std::make_pair(trip1.time, trip1.person_id) < std::make_pair(trip2.time, trip2.person_id);
+    });
+    for (auto& trip : trips) {
+        world.get_trip_list().add_trip(trip);
+    }
+    world.get_trip_list().use_weekday_trips_on_weekend();
+    world.use_migration_rules(false);
+}
+
+mio::abm::Simulation make_simulation(size_t num_persons, const AbmBenchmarkSetup& setup,
+                                     std::initializer_list<uint32_t> seeds)
 {
     auto rng = mio::RandomNumberGenerator();
     rng.seed(seeds);
@@ -35,7 +105,7 @@ mio::abm::Simulation make_simulation(size_t num_persons, std::initializer_list<u
          {mio::abm::LocationType::School, mio::abm::LocationType::Work, mio::abm::LocationType::SocialEvent,
           mio::abm::LocationType::BasicsShop, mio::abm::LocationType::Hospital, mio::abm::LocationType::ICU}) {
 
-        const auto num_locs = std::max(size_t(1), num_persons / 2'000);
+        const auto num_locs = std::max(size_t(1), num_persons / setup.persons_per_location);
         std::vector<mio::abm::LocationId> locs(num_locs);
         std::generate(locs.begin(), locs.end(), [&] {
             return world.add_location(loc_type);
@@ -91,43 +161,71 @@ mio::abm::Simulation make_simulation(size_t num_persons, std::initializer_list<u
         return mio::abm::TestingCriteria(random_ages, random_states);
     };
 
-    world.get_testing_strategy().add_testing_scheme(
-        mio::abm::LocationType::School,
-        mio::abm::TestingScheme(random_criteria(), mio::abm::days(3), mio::abm::TimePoint(0),
-                                mio::abm::TimePoint(0) + mio::abm::days(10), {}, 0.5));
-    world.get_testing_strategy().add_testing_scheme(
-        mio::abm::LocationType::Work,
-        mio::abm::TestingScheme(random_criteria(), mio::abm::days(3), mio::abm::TimePoint(0),
-                                mio::abm::TimePoint(0) + mio::abm::days(10), {}, 0.5));
-    world.get_testing_strategy().add_testing_scheme(
-        mio::abm::LocationType::Home,
-        mio::abm::TestingScheme(random_criteria(), mio::abm::days(3), mio::abm::TimePoint(0),
-                                mio::abm::TimePoint(0) + mio::abm::days(10), {}, 0.5));
-    world.get_testing_strategy().add_testing_scheme(
-        mio::abm::LocationType::SocialEvent,
-        mio::abm::TestingScheme(random_criteria(), mio::abm::days(3), mio::abm::TimePoint(0),
-                                mio::abm::TimePoint(0) + mio::abm::days(10), {}, 0.5));
+    const auto tested_location_types =
+        std::array{mio::abm::LocationType::School, mio::abm::LocationType::Work, mio::abm::LocationType::Home,
+                   mio::abm::LocationType::SocialEvent, mio::abm::LocationType::BasicsShop};
+    for (size_t i = 0; i < setup.num_testing_schemes; ++i) {
+        world.get_testing_strategy().add_testing_scheme(
+            tested_location_types[i % tested_location_types.size()],
+            mio::abm::TestingScheme(random_criteria(), mio::abm::days(3), mio::abm::TimePoint(0),
+                                    mio::abm::TimePoint(0) + mio::abm::days(10), {}, 0.5));
+    }
+
+    if (setup.mobility == Mobility::Trips) {
+        add_trips(world);
+    }
 
     return mio::abm::Simulation(mio::abm::TimePoint(0), std::move(world));
 }
 
+/**
+ * Hooks that measure the wall time of each phase of the simulation steps.
+ */
+struct PhaseTimer {
+    using Clock = std::chrono::steady_clock;
+
+    void start()
+    {
+        last = Clock::now();
+    }
+
+    void on_phase_end(mio::abm::StepPhase phase, mio::abm::TimePoint /*t*/, mio::abm::TimeSpan /*dt*/)
+    {
+        auto now = Clock::now();
+        seconds[size_t(phase)] += std::chrono::duration<double>(now - last).count();
+        last = now;
+    }
+
+    Clock::time_point last;
+    std::array<double, 4> seconds{}; ///< accumulated time per mio::abm::StepPhase.
+};
+
 /**
  * Benchmark for the ABM simulation.
- * @param num_persons Number of persons in the simulation.
- * @param seeds Seeds for the random number generator. 
+ * Benchmark arguments are the number of persons and the number of threads (0 for the default number of threads).
+ * The time spent in each phase of the steps is reported as counters.
+ * @param setup Configuration of the simulation.
+ * @param seeds Seeds for the random number generator.
  */
-void abm_benchmark(benchmark::State& state, size_t num_persons, std::initializer_list<uint32_t> seeds)
+void abm_benchmark(benchmark::State& state, AbmBenchmarkSetup setup, std::initializer_list<uint32_t> seeds)
 {
     mio::set_log_level(mio::LogLevel::warn);
 
+    static const int default_num_threads = mio::get_omp_max_threads();
+    auto num_persons                     = size_t(state.range(0));
+    auto num_threads                     = state.range(1) > 0 ? int(state.range(1)) : default_num_threads;
+    mio::set_omp_num_threads(num_threads);
+
+    PhaseTimer timer;
     for (auto&& _ : state) {
         state.PauseTiming(); //exclude the setup from the benchmark
-        auto sim = make_simulation(num_persons, seeds);
+        auto sim = make_simulation(num_persons, setup, seeds);
         state.ResumeTiming();
 
         //simulated time should be long enough to have full infection runs and migration to every location
-        auto final_time = sim.get_time() + mio::abm::days(10);
-        sim.advance(final_time);
+        auto final_time = sim.get_time() + mio::abm::days(setup.num_days);
+        timer.start();
+        sim.advance_with_hooks(final_time, timer);
 
         //debug output can be enabled to check for unexpected results (e.g. infections dieing out)
         //normally should have no significant effect on runtime
@@ -142,18 +240,101 @@ void abm_benchmark(benchmark::State& state, size_t num_persons, std::initializer
             }
         }
     }
+
+    mio::set_omp_num_threads(default_num_threads);
+    state.counters["num_threads"] = num_threads;
+    state.counters["person_days_per_second"] =
+        benchmark::Counter(double(num_persons) * setup.num_days, benchmark::Counter::kIsIterationInvariantRate);
+    const auto phase_names = std::array{"begin_step", "interaction", "migration", "trips"};
+    for (size_t phase = 0; phase < phase_names.size(); ++phase) {
+        state.counters[phase_names[phase]] =
+            benchmark::Counter(timer.seconds[phase], benchmark::Counter::kAvgIterations);
+    }
 }
 
-//Measure ABM simulation run time with different sizes and different seeds.
+//Measure ABM simulation run time with different sizes, thread counts and setups.
 //Fixed RNG seeds to make runs comparable. When there are code changes, the simulation will still
 //run differently due to different sequence of random numbers being drawn. But for large enough sizes
 //RNG should average out, so runs should be comparable even with code changes.
-//We run a few different benchmarks to hopefully catch abnormal cases. Then seeds may
-//have to be adjusted to get the benchmark back to normal.
 //For small sizes (e.g. 10k) extreme cases are too likely, i.e. infections die out
-//or overwhelm everything, so we don't benchmark these. Results should be mostly transferrable.
-BENCHMARK_CAPTURE(abm_benchmark, abm_benchmark_50k, 50000, {14159265u, 35897932u})->Unit(benchmark::kMillisecond);
-BENCHMARK_CAPTURE(abm_benchmark, abm_benchmark_100k, 100000, {38462643u, 38327950u})->Unit(benchmark::kMillisecond);
-BENCHMARK_CAPTURE(abm_benchmark, abm_benchmark_200k, 200000, {28841971u, 69399375u})->Unit(benchmark::kMillisecond);
+//or overwhelm everything, so these are only used to check the scaling with the number of persons.
+//Benchmark arguments: {number of persons, number of threads}, 0 threads uses OMP_NUM_THREADS.
+const auto default_setup = AbmBenchmarkSetup{Mobility::Rules, 4, 2'000, 10};
 
-BENCHMARK_MAIN();
+//strong scaling: fixed number of persons, increasing number of threads.
+BENCHMARK_CAPTURE(abm_benchmark, strong_scaling, default_setup, {14159265u, 35897932u})
+    ->ArgsProduct({{200'000}, {1, 2, 4, 8, 16, 32}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+//weak scaling: fixed number of persons per thread.
+BENCHMARK_CAPTURE(abm_benchmark, weak_scaling, default_setup, {38462643u, 38327950u})
+    ->Args({50'000, 1})
+    ->Args({100'000, 2})
+    ->Args({200'000, 4})
+    ->Args({400'000, 8})
+    ->Args({800'000, 16})
+    ->Args({1'600'000, 32})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+//number of persons from 10k to 5M, shorter simulated time so large sizes are feasible.
+BENCHMARK_CAPTURE(abm_benchmark, num_persons, (AbmBenchmarkSetup{Mobility::Rules, 4, 2'000, 2}),
+                  {28841971u, 69399375u})
+    ->ArgsProduct({{10'000, 100'000, 1'000'000, 5'000'000}, {0}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+//daily routine from trips instead of migration rules.
+BENCHMARK_CAPTURE(abm_benchmark, trip_mobility, (AbmBenchmarkSetup{Mobility::Trips, 4, 2'000, 10}),
+                  {14159265u, 35897932u})
+    ->Args({100'000, 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(abm_benchmark, rule_mobility, default_setup, {14159265u, 35897932u})
+    ->Args({100'000, 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+//few and many testing schemes.
+BENCHMARK_CAPTURE(abm_benchmark, few_testing_schemes, (AbmBenchmarkSetup{Mobility::Rules, 1, 2'000, 10}),
+                  {14159265u, 35897932u})
+    ->Args({100'000, 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK_CAPTURE(abm_benchmark, many_testing_schemes, (AbmBenchmarkSetup{Mobility::Rules, 50, 2'000, 10}),
+                  {14159265u, 35897932u})
+    ->Args({100'000, 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+//few very large locations, e.g. big workplaces or events.
+BENCHMARK_CAPTURE(abm_benchmark, large_locations, (AbmBenchmarkSetup{Mobility::Rules, 4, 50'000, 10}),
+                  {14159265u, 35897932u})
+    ->Args({100'000, 0})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+//Results are written to abm_benchmark.json by default so they can be tracked across releases,
+//use --benchmark_out=<file> to write them somewhere else.
+int main(int argc, char** argv)
+{
+    std::vector<char*> args(argv, argv + argc);
+    std::string out_arg    = "--benchmark_out=abm_benchmark.json";
+    std::string format_arg = "--benchmark_out_format=json";
+    if (std::none_of(args.begin() + 1, args.end(), [](auto arg) {
+            return std::string(arg).rfind("--benchmark_out=", 0) == 0;
+        })) {
+        args.push_back(&out_arg[0]);
+        args.push_back(&format_arg[0]);
+    }
+    int num_args = int(args.size());
+    benchmark::Initialize(&num_args, args.data());
+    if (benchmark::ReportUnrecognizedArguments(num_args, args.data())) {
+        return 1;
+    }
+    benchmark::AddCustomContext("omp_max_threads", std::to_string(mio::get_omp_max_threads()));
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "benchmarks/secir_ageres_setups.h"
+#include "memilio/epidemiology/contact_matrix.h"
+
+#include "benchmark/benchmark.h"
+
+/**
+ * @brief Contact matrices of the locations home, school, work and other with dampings at several times.
+ */
+mio::ContactMatrixGroup make_contact_matrices(int num_groups)
+{
+    mio::ContactMatrixGroup contact_matrices(4, num_groups);
+    for (auto& cm : contact_matrices) {
+        cm = mio::ContactMatrix(Eigen::MatrixXd::Constant(num_groups, num_groups, 1.0 / num_groups));
+    }
+    for (int i = 0; i < 10; ++i) {
+        contact_matrices.add_damping(0.1 * (i % 5), mio::DampingLevel(i % 3), mio::DampingType(i % 2),
+                                     mio::SimulationTime(10.0 * i));
+    }
+    return contact_matrices;
+}
+
+/**
+ * @brief Access all coefficients of the expression, like the models did before.
+ */
+void contact_matrix_coefficients(::benchmark::State& state)
+{
+    auto num_groups       = int(state.range(0));
+    auto contact_matrices = make_contact_matrices(num_groups);
+    auto t                = 0.0;
+    for (auto _ : state) {
+        auto sum = 0.0;
+        for (Eigen::Index i = 0; i < num_groups; ++i) {
+            for (Eigen::Index j = 0; j < num_groups; ++j) {
+                sum += contact_matrices.get_matrix_at(t)(i, j);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        t = std::fmod(t + 0.1, 100.0);
+    }
+}
+
+/**
+ * @brief Evaluate the matrix once into a buffer and access the buffer.
+ */
+void contact_matrix_materialized(::benchmark::State& state)
+{
+    auto num_groups       = int(state.range(0));
+    auto contact_matrices = make_contact_matrices(num_groups);
+    auto t                = 0.0;
+    Eigen::MatrixXd buffer;
+    for (auto _ : state) {
+        contact_matrices.get_matrix_at(t, buffer);
+        auto sum = 0.0;
+        for (Eigen::Index i = 0; i < num_groups; ++i) {
+            for (Eigen::Index j = 0; j < num_groups; ++j) {
+                sum += buffer(i, j);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+        t = std::fmod(t + 0.1, 100.0);
+    }
+}
+
+/**
+ * @brief Right hand side of the SECIR model, which evaluates the contact matrix once per call.
+ */
+void secir_get_flows(::benchmark::State& state)
+{
+    mio::set_log_level(mio::LogLevel::critical);
+    auto model = mio::benchmark::model::SecirAgeresDampings(size_t(state.range(0)));
+    auto y     = model.get_initial_values().eval();
+    Eigen::VectorXd flows(model.get_initial_flows().size());
+    auto t = 0.0;
+    for (auto _ : state) {
+        flows.setZero();
+        model.get_flows(y, y, t, flows);
+        benchmark::DoNotOptimize(flows.data());
+        t = std::fmod(t + 0.1, 100.0);
+    }
+}
+
+BENCHMARK(contact_matrix_coefficients)->Arg(16)->Arg(32)->Arg(64);
+BENCHMARK(contact_matrix_materialized)->Arg(16)->Arg(32)->Arg(64);
+BENCHMARK(secir_get_flows)->Arg(16)->Arg(32)->Arg(64);
+BENCHMARK_MAIN();
@@ -0,0 +1,68 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/compartments/batch_simulation.h"
+#include "memilio/math/adapt_rk.h"
+#include "ode_sir/model.h"
+
+#include "benchmark/benchmark.h"
+
+/**
+ * @brief Members of an ensemble of SIR models with slightly different parameters.
+ */
+template <class FP>
+std::vector<mio::osir::Model<FP>> make_ensemble(size_t num_members)
+{
+    std::vector<mio::osir::Model<FP>> models(num_members);
+    for (size_t i = 0; i < num_members; ++i) {
+        auto& model = models[i];
+        model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Infected)}]    = 1000;
+        model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Recovered)}]   = 1000;
+        model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Susceptible)}] = 1e6;
+        model.parameters.template set<mio::osir::TimeInfected>(2 + 0.1 * (i % 10));
+        model.parameters.template set<mio::osir::TransmissionProbabilityOnContact>(0.5);
+        model.parameters.template get<mio::osir::ContactPatterns>().get_baseline()(0, 0) = 2.7;
+    }
+    return models;
+}
+
+/**
+ * @brief Simulate an ensemble with shared step size control, the states are integrated in precision FP.
+ * Both precisions use the same Runge-Kutta-Fehlberg scheme.
+ */
+template <class FP>
+void ensemble_sir(::benchmark::State& state)
+{
+    mio::set_log_level(mio::LogLevel::critical);
+    auto models    = make_ensemble<FP>(size_t(state.range(0)));
+    auto num_steps = Eigen::Index(0);
+    for (auto _ : state) {
+        mio::BatchSimulation<mio::osir::Model<FP>> sim(models, 0., 0.1);
+        sim.set_integrator(std::make_shared<mio::BasicRKIntegratorCore<FP>>());
+        sim.advance(20.);
+        num_steps = sim.get_result(0).get_num_time_points() - 1;
+        benchmark::DoNotOptimize(sim.get_result(0).get_last_value().data());
+    }
+    // the error estimate is rounded to the precision of FP, so the step sizes may differ
+    state.counters["steps"] = double(num_steps);
+}
+
+BENCHMARK_TEMPLATE(ensemble_sir, double)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(ensemble_sir, float)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+BENCHMARK_MAIN();
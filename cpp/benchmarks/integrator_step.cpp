@@ -21,6 +21,8 @@
 #include "benchmarks/secir_ageres_setups.h"
 
 #include "memilio/math/adapt_rk.h"
+#include "memilio/math/dormand_prince.h"
+#include "memilio/math/rosenbrock.h"
 #include "memilio/math/stepper_wrapper.h"
 
 template <class Integrator>
@@ -56,6 +58,8 @@ BENCHMARK_TEMPLATE(integrator_step, mio::RKIntegratorCore)->Name("Dummy 2/3");
 BENCHMARK_TEMPLATE(integrator_step, mio::RKIntegratorCore)->Name("Dummy 3/3");
 // register functions as a benchmarks and set a name
 BENCHMARK_TEMPLATE(integrator_step, mio::RKIntegratorCore)->Name("simulate SecirModel adapt_rk");
+BENCHMARK_TEMPLATE(integrator_step, mio::DormandPrinceIntegratorCore)->Name("simulate SecirModel dormand_prince");
+BENCHMARK_TEMPLATE(integrator_step, mio::RosenbrockIntegratorCore)->Name("simulate SecirModel rosenbrock");
 BENCHMARK_TEMPLATE(integrator_step, mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_cash_karp54>)
     ->Name("simulate SecirModel boost rk_ck54");
 // BENCHMARK_TEMPLATE(integrator_step, mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_dopri5>)
@@ -0,0 +1,295 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_COMPARTMENTS_BATCH_SIMULATION_H
+#define MIO_COMPARTMENTS_BATCH_SIMULATION_H
+
+#include "memilio/config.h"
+#include "memilio/compartments/simulation.h"
+#include "memilio/math/integrator.h"
+#include "memilio/utils/time_series.h"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace mio
+{
+
+/**
+ * @brief Step size control of a BatchSimulation.
+ */
+enum class BatchStepSizeControl
+{
+    Shared, ///< All members are integrated as one system with the same time steps.
+    PerMember, ///< Every member is integrated with its own time steps.
+};
+
+/**
+ * @brief Simulation of many independent models of the same type and size, e.g. the runs of a parameter study.
+ *
+ * With shared step size control, the states of all members are packed into one vector (member i uses the entries
+ * [i * n, (i + 1) * n) for models with n compartments) that is integrated as one system.
+ * The integrator does all linear combinations of the stages for all members at once, the right hand side evaluates
+ * the models one after another on their part of the packed state. The adaptive step size is the smallest step size
+ * that satisfies the tolerances of all members, so the members also share the time points of the results.
+ * This is efficient for many small models with similar dynamics.
+ * With step size control per member, every member is integrated separately with its own adaptive step size.
+ * The states and results have the floating point type of the model, see model_scalar_t. Use e.g. float to halve
+ * the memory traffic of large batches.
+ *
+ * @tparam M a CompartmentModel type.
+ */
+template <class M>
+class BatchSimulation
+{
+    static_assert(is_compartment_model<M>::value, "Template parameter must be a compartment model.");
+
+public:
+    using Model  = M;
+    using Scalar = model_scalar_t<M>;
+
+    /**
+     * @brief Set up the simulation with an ODE solver.
+     * @param[in] models The members of the batch. All models must have the same number of compartments.
+     * @param[in] t0 Start time.
+     * @param[in] dt Initial step size of integration.
+     * @param[in] control Step size control, shared by all members or per member.
+     */
+    BatchSimulation(std::vector<Model> models, double t0 = 0., double dt = 0.1,
+                    BatchStepSizeControl control = BatchStepSizeControl::Shared)
+        : m_integratorCore(std::make_shared<BasicDefaultIntegratorCore<Scalar>>())
+        , m_models(std::move(models))
+        , m_integrator(m_integratorCore)
+        , m_control(control)
+        , m_dt(control == BatchStepSizeControl::Shared ? 1 : m_models.size(), dt)
+    {
+        assert(!m_models.empty());
+        m_num_compartments = m_models[0].get_initial_values().size();
+        m_results.reserve(m_models.size());
+        for (auto& model : m_models) {
+            assert(model.get_initial_values().size() == m_num_compartments &&
+                   "All members must have the same number of compartments.");
+            m_results.emplace_back(t0, model.get_initial_values());
+        }
+    }
+
+    /**
+     * @brief Set the integrator core used for all members.
+     * @param[in] integrator A shared pointer to an object derived from BasicIntegratorCore.
+     */
+    void set_integrator(std::shared_ptr<BasicIntegratorCore<Scalar>> integrator)
+    {
+        m_integratorCore = std::move(integrator);
+        m_integrator.set_integrator(m_integratorCore);
+    }
+
+    /**
+     * @brief Access the integrator core used for all members.
+     * @{
+     */
+    BasicIntegratorCore<Scalar>& get_integrator()
+    {
+        return *m_integratorCore;
+    }
+    BasicIntegratorCore<Scalar> const& get_integrator() const
+    {
+        return *m_integratorCore;
+    }
+    /** @} */
+
+    /**
+     * @brief Get the number of members.
+     */
+    size_t get_num_members() const
+    {
+        return m_models.size();
+    }
+
+    /**
+     * @brief Get the step size control.
+     */
+    BatchStepSizeControl get_step_size_control() const
+    {
+        return m_control;
+    }
+
+    /**
+     * @brief Advance all members to tmax.
+     * tmax must be greater than the last time point of the results.
+     * Changes to the last value of the result of a member, e.g. by migration, are used by the next call.
+     * @param tmax next stopping point of the simulation.
+     */
+    void advance(double tmax)
+    {
+        if (m_control == BatchStepSizeControl::Shared) {
+            advance_shared(tmax);
+        }
+        else {
+            advance_per_member(tmax);
+        }
+    }
+
+    /**
+     * @brief Get the result of one member.
+     * @param i index of the member.
+     * @return TimeSeries of the populations of the member.
+     * @{
+     */
+    TimeSeries<Scalar>& get_result(size_t i)
+    {
+        return m_results[i];
+    }
+    const TimeSeries<Scalar>& get_result(size_t i) const
+    {
+        return m_results[i];
+    }
+    /** @} */
+
+    /**
+     * @brief Get the model of one member.
+     * @param i index of the member.
+     * @{
+     */
+    Model& get_model(size_t i)
+    {
+        return m_models[i];
+    }
+    const Model& get_model(size_t i) const
+    {
+        return m_models[i];
+    }
+    /** @} */
+
+    /**
+     * @brief Returns the step size used by the integrator for one member.
+     * With shared step size control, all members use the same step size.
+     * @param i index of the member.
+     * @{
+     */
+    double& get_dt(size_t i)
+    {
+        return m_control == BatchStepSizeControl::Shared ? m_dt[0] : m_dt[i];
+    }
+    const double& get_dt(size_t i) const
+    {
+        return m_control == BatchStepSizeControl::Shared ? m_dt[0] : m_dt[i];
+    }
+    /** @} */
+
+private:
+    /**
+     * @brief Integrate the packed states of all members with shared time steps.
+     */
+    void advance_shared(double tmax)
+    {
+        const auto n      = m_num_compartments;
+        const auto t0     = m_results[0].get_last_time();
+        const auto num_tp = m_results[0].get_num_time_points();
+
+        //pack the last values, they may have been changed since the last call
+        m_packed_result = TimeSeries<Scalar>(Eigen::Index(m_models.size()) * n);
+        auto y0         = m_packed_result.add_time_point(t0);
+        for (size_t i = 0; i < m_models.size(); ++i) {
+            assert(m_results[i].get_num_time_points() == num_tp && m_results[i].get_last_time() == t0 &&
+                   "Results of the members must have the same time points with shared step size control.");
+            y0.segment(Eigen::Index(i) * n, n) = m_results[i].get_last_value();
+        }
+        m_integrator.advance(
+            [this, n](auto&& y, auto&& t, auto&& dydt) {
+                for (size_t i = 0; i < m_models.size(); ++i) {
+                    const auto offset = Eigen::Index(i) * n;
+                    m_models[i].eval_right_hand_side(y.segment(offset, n), y.segment(offset, n), t,
+                                                     dydt.segment(offset, n));
+                }
+            },
+            tmax, m_dt[0], m_packed_result);
+
+        //unpack the new time points
+        for (size_t i = 0; i < m_models.size(); ++i) {
+            auto& result = m_results[i];
+            result.reserve(num_tp + m_packed_result.get_num_time_points() - 1);
+            for (Eigen::Index j = 1; j < m_packed_result.get_num_time_points(); ++j) {
+                result.add_time_point(m_packed_result.get_time(j),
+                                      m_packed_result.get_value(j).segment(Eigen::Index(i) * n, n));
+            }
+        }
+    }
+
+    /**
+     * @brief Integrate every member on its own with its own time steps.
+     */
+    void advance_per_member(double tmax)
+    {
+        for (size_t i = 0; i < m_models.size(); ++i) {
+            auto& model = m_models[i];
+            m_integrator.advance(
+                [&model](auto&& y, auto&& t, auto&& dydt) {
+                    model.eval_right_hand_side(y, y, t, dydt);
+                },
+                tmax, m_dt[i], m_results[i]);
+        }
+    }
+
+    std::shared_ptr<BasicIntegratorCore<Scalar>> m_integratorCore; ///< Defines the integration scheme.
+    std::vector<Model> m_models; ///< The members of the batch.
+    BasicOdeIntegrator<Scalar> m_integrator; ///< Integrates the members.
+    BatchStepSizeControl m_control; ///< Step size control, shared or per member.
+    std::vector<double> m_dt; ///< Step size, one for all members or one per member.
+    Eigen::Index m_num_compartments; ///< Number of compartments of each member.
+    std::vector<TimeSeries<Scalar>> m_results; ///< The results of the members.
+    TimeSeries<Scalar> m_packed_result{0}; ///< Packed states of all members during advance_shared.
+};
+
+/**
+ * @brief Run a BatchSimulation of many CompartmentalModels of the same type and size.
+ * @param[in] t0 Start time.
+ * @param[in] tmax End time.
+ * @param[in] dt Initial step size of integration.
+ * @param[in] models The members of the batch.
+ * @param[in] control Step size control, shared by all members or per member.
+ * @param[in] integrator Optionally override the IntegratorCore used by the BatchSimulation.
+ * @return The results of all members.
+ * @tparam Model The particular Model derived from CompartmentModel to simulate.
+ */
+template <class Model>
+std::vector<TimeSeries<model_scalar_t<Model>>>
+simulate_batch(double t0, double tmax, double dt, std::vector<Model> models,
+               BatchStepSizeControl control = BatchStepSizeControl::Shared,
+               std::shared_ptr<BasicIntegratorCore<model_scalar_t<Model>>> integrator = nullptr)
+{
+    for (auto& model : models) {
+        model.check_constraints();
+    }
+    BatchSimulation<Model> sim(std::move(models), t0, dt, control);
+    if (integrator) {
+        sim.set_integrator(integrator);
+    }
+    sim.advance(tmax);
+    std::vector<TimeSeries<model_scalar_t<Model>>> results;
+    results.reserve(sim.get_num_members());
+    for (size_t i = 0; i < sim.get_num_members(); ++i) {
+        results.push_back(std::move(sim.get_result(i)));
+    }
+    return results;
+}
+
+} // namespace mio
+
+#endif // MIO_COMPARTMENTS_BATCH_SIMULATION_H
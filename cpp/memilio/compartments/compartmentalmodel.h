@@ -42,6 +42,16 @@ using check_constraints_expr_t = decltype(std::declval<T>().check_constraints())
 template <class T>
 using apply_constraints_expr_t = decltype(std::declval<T>().apply_constraints());
 
+//helpers for model_scalar_t
+template <class M, class = void>
+struct ModelScalar {
+    using Type = double;
+};
+template <class M>
+struct ModelScalar<M, void_t<typename M::Scalar>> {
+    using Type = typename M::Scalar;
+};
+
 } //namespace details
 
 /**
@@ -71,13 +81,17 @@ using has_apply_constraints_member_function = is_expression_valid<details::apply
  * when defining the flows between compartments and they can be used for parameter
  * studies
  *
+ * The state y of the ODE has entries of type FP, e.g. float to halve the memory traffic in large ensembles.
+ * The populations and parameters are stored as before, models convert them to FP when computing the derivatives.
+ *
  */
-template <class Comp, class Pop, class Params>
+template <class Comp, class Pop, class Params, class FP = ScalarType>
 struct CompartmentalModel {
 public:
     using Compartments = Comp;
     using Populations  = Pop;
     using ParameterSet = Params;
+    using Scalar       = FP;
 
     /**
      * @brief CompartmentalModel default constructor
@@ -95,8 +109,8 @@ public:
     virtual ~CompartmentalModel()                            = default;
 
     //REMARK: Not pure virtual for easier java/python bindings
-    virtual void get_derivatives(Eigen::Ref<const Eigen::VectorXd>, Eigen::Ref<const Eigen::VectorXd> /*y*/,
-                                 double /*t*/, Eigen::Ref<Eigen::VectorXd> /*dydt*/) const {};
+    virtual void get_derivatives(Eigen::Ref<const Vector<FP>>, Eigen::Ref<const Vector<FP>> /*y*/, double /*t*/,
+                                 Eigen::Ref<Vector<FP>> /*dydt*/) const {};
     /**
      * @brief eval_right_hand_side evaulates the right-hand-side f of the ODE dydt = f(y, t)
      *
@@ -117,8 +131,8 @@ public:
      * @param t the current time
      * @param dydt a reference to the calculated output
      */
-    void eval_right_hand_side(Eigen::Ref<const Eigen::VectorXd> pop, Eigen::Ref<const Eigen::VectorXd> y, double t,
-                              Eigen::Ref<Eigen::VectorXd> dydt) const
+    void eval_right_hand_side(Eigen::Ref<const Vector<FP>> pop, Eigen::Ref<const Vector<FP>> y, double t,
+                              Eigen::Ref<Vector<FP>> dydt) const
     {
         dydt.setZero();
         this->get_derivatives(pop, y, t, dydt);
@@ -129,9 +143,9 @@ public:
      * This can be used as initial conditions in an ODE solver
      * @return the initial populatoins
      */
-    Eigen::VectorXd get_initial_values() const
+    Vector<FP> get_initial_values() const
     {
-        return populations.get_compartments();
+        return populations.get_compartments().template cast<FP>();
     }
 
     void apply_constraints()
@@ -154,6 +168,14 @@ public:
     ParameterSet parameters{};
 };
 
+/**
+ * @brief The floating point type of the state of a compartment model.
+ * M::Scalar if the model defines it, e.g. a CompartmentalModel, otherwise double.
+ * @tparam M a compartment model type.
+ */
+template <class M>
+using model_scalar_t = typename details::ModelScalar<M>::Type;
+
 /**
  * detect the eval_right_hand_side member function of a compartment model.
  * If the eval_right_hand_side member function exists in the type M, this template when instatiated
@@ -163,8 +185,9 @@ public:
  */
 template <class M>
 using eval_right_hand_side_expr_t = decltype(std::declval<const M&>().eval_right_hand_side(
-    std::declval<Eigen::Ref<const Eigen::VectorXd>>(), std::declval<Eigen::Ref<const Eigen::VectorXd>>(),
-    std::declval<double>(), std::declval<Eigen::Ref<Eigen::VectorXd>>()));
+    std::declval<Eigen::Ref<const Vector<model_scalar_t<M>>>>(),
+    std::declval<Eigen::Ref<const Vector<model_scalar_t<M>>>>(), std::declval<double>(),
+    std::declval<Eigen::Ref<Vector<model_scalar_t<M>>>>()));
 
 /**
  * detect the get_initial_values member function of a compartment model.
@@ -175,7 +198,7 @@ using eval_right_hand_side_expr_t = decltype(std::declval<const M&>().eval_right
  */
 template <class M>
 using get_initial_values_expr_t =
-    decltype(std::declval<Eigen::VectorXd&>() = std::declval<const M&>().get_initial_values());
+    decltype(std::declval<Vector<model_scalar_t<M>>&>() = std::declval<const M&>().get_initial_values());
 
 /**
  * Template meta function to check if a type is a valid compartment model. 
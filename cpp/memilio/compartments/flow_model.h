@@ -22,10 +22,20 @@
 #define MIO_FLOW_MODEL_H_
 
 #include "memilio/compartments/compartmentalmodel.h"
+#include "memilio/math/eigen_sparse.h"
 #include "memilio/utils/index_range.h"
 #include "memilio/utils/flow.h"
 #include "memilio/utils/type_list.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace mio
 {
 
@@ -68,9 +78,10 @@ using filtered_index_t = decltype(
  *
  * Flows is expected to be a TypeList containing types Flow<A,B>, where A and B are compartments from the enum Comp.
  * Some examples can be found in the cpp/models/ directory, within the model.h files.
+ * The flows have entries of type FP, like the state of the CompartmentalModel.
  */
-template <class Comp, class Pop, class Params, class Flows>
-class FlowModel : public CompartmentalModel<Comp, Pop, Params>
+template <class Comp, class Pop, class Params, class Flows, class FP = ScalarType>
+class FlowModel : public CompartmentalModel<Comp, Pop, Params, FP>
 {
     using PopIndex = typename Pop::Index;
     // FlowIndex is the same as PopIndex without the category Comp. It is used as argument type for
@@ -84,42 +95,46 @@ class FlowModel : public CompartmentalModel<Comp, Pop, Params>
     static_assert(FlowIndex::size == PopIndex::size - 1, "Compartments must be used exactly once as population index.");
 
 public:
-    using Base = CompartmentalModel<Comp, Pop, Params>;
+    using Base = CompartmentalModel<Comp, Pop, Params, FP>;
     /**
      * @brief Default constructor, forwarding args to Base constructor.
      */
     template <class... Args>
     FlowModel(Args... args)
-        : CompartmentalModel<Comp, Pop, Params>(args...)
+        : CompartmentalModel<Comp, Pop, Params, FP>(args...)
         , m_flow_values((this->populations.numel() / static_cast<size_t>(Comp::Count)) * Flows::size())
+        , m_flow_table_dimensions(this->populations.size())
     {
+        make_flow_tables();
     }
 
     // Note: use get_flat_flow_index when accessing flows
     // Note: by convention, we compute incoming flows, thus entries in flows must be non-negative
-    virtual void get_flows(Eigen::Ref<const Eigen::VectorXd> /*pop*/, Eigen::Ref<const Eigen::VectorXd> /*y*/,
-                           double /*t*/, Eigen::Ref<Eigen::VectorXd> /*flows*/) const = 0;
+    virtual void get_flows(Eigen::Ref<const Vector<FP>> /*pop*/, Eigen::Ref<const Vector<FP>> /*y*/, double /*t*/,
+                           Eigen::Ref<Vector<FP>> /*flows*/) const = 0;
 
     /**
      * @brief Compute the right-hand-side of the ODE dydt = f(y, t) from flow values.
      *
-     * This function is generated at compile time depending on the template parameters Flows and Pop of the model.
+     * The source and target compartment of every flow are known at compile time from the template parameter Flows.
+     * The flat population index of the first compartment for every FlowIndex is computed once (and again only if the
+     * dimensions of the populations change), so the flat indices of all flows are simple sums.
      *
      * @param[in] flows The current flow values (as calculated by get_flows) as a flat array.
      * @param[out] dydt A reference to the calculated output.
      */
-    void get_derivatives(Eigen::Ref<const Eigen::VectorXd> flows, Eigen::Ref<Eigen::VectorXd> dydt) const
+    void get_derivatives(Eigen::Ref<const Vector<FP>> flows, Eigen::Ref<Vector<FP>> dydt) const
     {
+        update_flow_tables();
         // set dydt to 0, then iteratively add all flow contributions
         dydt.setZero();
-        if constexpr (std::is_same_v<FlowIndex, Index<>>) {
-            // special case where PopIndex only contains Comp, hence FlowIndex has no dimensions to iterate over
-            get_rhs_impl(flows, dydt, Index<>{});
-        }
-        else {
-            for (FlowIndex I : make_index_range(reduce_index<FlowIndex>(this->populations.size()))) {
-                get_rhs_impl(flows, dydt, I);
-            }
+        const auto num_blocks = m_population_offsets.size();
+        for (size_t block = 0; block < num_blocks; ++block) {
+            // if Comp is the last category, the populations are ordered like the flows
+            const auto population_offset = compartments_are_consecutive
+                                               ? block * static_cast<size_t>(Comp::Count)
+                                               : m_population_offsets[block];
+            get_rhs_impl(flows, dydt, block * Flows::size(), population_offset);
         }
     }
 
@@ -134,22 +149,90 @@ public:
      * @param[in] t The current time.
      * @param[out] dydt A reference to the calculated output.
      */
-    void get_derivatives(Eigen::Ref<const Eigen::VectorXd> pop, Eigen::Ref<const Eigen::VectorXd> y, double t,
-                         Eigen::Ref<Eigen::VectorXd> dydt) const override final
+    void get_derivatives(Eigen::Ref<const Vector<FP>> pop, Eigen::Ref<const Vector<FP>> y, double t,
+                         Eigen::Ref<Vector<FP>> dydt) const override final
     {
         m_flow_values.setZero();
         get_flows(pop, y, t, m_flow_values);
         get_derivatives(m_flow_values, dydt);
     }
 
+    /**
+     * @brief The stoichiometry matrix of the model.
+     *
+     * Column j of the matrix is the change of the populations by flow j, i.e. -1 in the row of the source and +1 in
+     * the row of the target compartment of the flow. Rows and columns use the flat indices of the populations and
+     * the flows (see get_flat_flow_index). Then get_derivatives(flows, dydt) is the same as dydt = S * flows.
+     * Use this to convert many flow values at once, e.g. all time points of a TimeSeries of flows:
+     * `pop = S * flows.matrix().bottomRows(flows.get_num_elements())`, or for linear algebra with the flows.
+     * get_derivatives(flows, dydt) does not need to multiply with the entries of the matrix, so it is faster
+     * for single vectors of flows and should be used in simulations.
+     *
+     * @return Sparse matrix of size (number of populations) x (number of flows).
+     */
+    const Eigen::SparseMatrix<FP>& get_stoichiometry() const
+    {
+        update_flow_tables();
+        return m_stoichiometry;
+    }
+
+    /**
+     * @brief Compute the jacobian of the flows with respect to the populations, d flows / d y.
+     *
+     * The populations and the state are both y, like in a Simulation. Entry (i, j) is the derivative of flow i
+     * (see get_flat_flow_index) with respect to population j (flat index).
+     * The default implementation uses forward differences of get_flows, which costs one evaluation of get_flows per
+     * population. Models should override it with the analytic jacobian if possible.
+     *
+     * @param[in] y The current state of the model as a flat array.
+     * @param[in] t The current time.
+     * @param[out] jac Jacobian of size (number of flows) x (number of populations).
+     */
+    virtual void get_flow_jacobian(Eigen::Ref<const Vector<FP>> y, double t,
+                                   Eigen::Ref<Eigen::Matrix<FP, Eigen::Dynamic, Eigen::Dynamic>> jac) const
+    {
+        const FP sqrt_eps = std::sqrt(std::numeric_limits<FP>::epsilon());
+        m_jacobian_state      = y;
+        m_jacobian_flows.resize(m_flow_values.size());
+        m_flow_values.setZero();
+        get_flows(y, y, t, m_flow_values);
+        for (Eigen::Index j = 0; j < y.size(); ++j) {
+            m_jacobian_state[j] = y[j] + sqrt_eps * std::max(std::abs(y[j]), FP(1.0));
+            m_jacobian_flows.setZero();
+            get_flows(m_jacobian_state, m_jacobian_state, t, m_jacobian_flows);
+            jac.col(j)          = (m_jacobian_flows - m_flow_values) / (m_jacobian_state[j] - y[j]);
+            m_jacobian_state[j] = y[j];
+        }
+    }
+
+    /**
+     * @brief Compute the jacobian of the right-hand-side f(y, t) of the ODE, d f / d y.
+     *
+     * The jacobian is the product of the stoichiometry matrix, whose sparse structure is known at compile time from
+     * the template parameter Flows, and the jacobian of the flows (see get_flow_jacobian). Can be used by implicit
+     * integrators, e.g. `core.set_jacobian([&model](auto&& y, auto&& t, auto&& jac) { model.get_jacobian(y, t, jac); })`
+     * for a RosenbrockIntegratorCore.
+     *
+     * @param[in] y The current state of the model as a flat array.
+     * @param[in] t The current time.
+     * @param[out] jac Jacobian of size (number of populations) x (number of populations).
+     */
+    void get_jacobian(Eigen::Ref<const Vector<FP>> y, double t,
+                      Eigen::Ref<Eigen::Matrix<FP, Eigen::Dynamic, Eigen::Dynamic>> jac) const
+    {
+        m_flow_jacobian.resize(m_flow_values.size(), y.size());
+        get_flow_jacobian(y, t, m_flow_jacobian);
+        jac.noalias() = get_stoichiometry() * m_flow_jacobian;
+    }
+
     /**
      * @brief Initial values for flows.
      * This can be used as initial conditions in an ODE solver. By default, this is a zero vector.
      * @return The initial flows.
      */
-    Eigen::VectorXd get_initial_flows() const
+    Vector<FP> get_initial_flows() const
     {
-        return Eigen::VectorXd::Zero((this->populations.numel() / static_cast<size_t>(Comp::Count)) * Flows::size());
+        return Vector<FP>::Zero((this->populations.numel() / static_cast<size_t>(Comp::Count)) * Flows::size());
     }
 
     /**
@@ -204,32 +287,116 @@ public:
     }
 
 private:
-    mutable Eigen::VectorXd m_flow_values; ///< Cache to avoid allocation in get_derivatives (using get_flows).
+    mutable Vector<FP> m_flow_values; ///< Cache to avoid allocation in get_derivatives (using get_flows).
+    mutable Vector<FP> m_jacobian_state, m_jacobian_flows; ///< Perturbed state and flows for get_flow_jacobian.
+    mutable Eigen::Matrix<FP, Eigen::Dynamic, Eigen::Dynamic> m_flow_jacobian; ///< Jacobian of the flows.
+    mutable PopIndex m_flow_table_dimensions; ///< Dimensions of the populations used for the flow tables.
+    mutable std::vector<size_t> m_population_offsets; ///< Flat population index of compartment 0 for each FlowIndex.
+    mutable size_t m_compartment_stride = 1; ///< Distance of the flat population indices of two compartments.
+    mutable Eigen::SparseMatrix<FP> m_stoichiometry; ///< Change of the populations by each flow.
+
+    // Comp is the last category of PopIndex in most models, so the compartments of one FlowIndex are consecutive.
+    static constexpr bool compartments_are_consecutive =
+        std::is_same_v<std::tuple_element_t<PopIndex::size - 1, decltype(details::as_tuple(std::declval<PopIndex>()))>,
+                       Comp>;
+
+    /**
+     * @brief Recompute the flow tables if the dimensions of the populations changed.
+     */
+    void update_flow_tables() const
+    {
+        if (!(this->populations.size() == m_flow_table_dimensions)) {
+            m_flow_table_dimensions = this->populations.size();
+            make_flow_tables();
+        }
+    }
+
+    /**
+     * @brief Compute the flat population offsets of each FlowIndex, the stride of the compartments and the
+     * stoichiometry matrix.
+     */
+    void make_flow_tables() const
+    {
+        m_population_offsets.clear();
+        auto add_offset = [this](const FlowIndex& index) {
+            const auto offset = this->populations.get_flat_index(extend_index<PopIndex>(index, size_t(0)));
+            m_population_offsets.push_back(offset);
+            if (static_cast<size_t>(Comp::Count) > 1) {
+                m_compartment_stride =
+                    this->populations.get_flat_index(extend_index<PopIndex>(index, size_t(1))) - offset;
+            }
+        };
+        if constexpr (std::is_same_v<FlowIndex, Index<>>) {
+            // special case where PopIndex only contains Comp, hence FlowIndex has no dimensions to iterate over
+            add_offset(Index<>{});
+        }
+        else {
+            for (FlowIndex index : make_index_range(reduce_index<FlowIndex>(this->populations.size()))) {
+                add_offset(index);
+            }
+        }
+
+        const auto num_flows = m_population_offsets.size() * Flows::size();
+        std::vector<Eigen::Triplet<FP>> entries;
+        entries.reserve(2 * num_flows);
+        for (size_t block = 0; block < m_population_offsets.size(); ++block) {
+            for (size_t flow = 0; flow < Flows::size(); ++flow) {
+                const auto j = Eigen::Index(block * Flows::size() + flow);
+                entries.emplace_back(Eigen::Index(m_population_offsets[block] +
+                                                  static_cast<size_t>(flow_sources[flow]) * m_compartment_stride),
+                                     j, FP(-1.0));
+                entries.emplace_back(Eigen::Index(m_population_offsets[block] +
+                                                  static_cast<size_t>(flow_targets[flow]) * m_compartment_stride),
+                                     j, FP(1.0));
+            }
+        }
+        m_stoichiometry.resize(Eigen::Index(this->populations.numel()), Eigen::Index(num_flows));
+        m_stoichiometry.setFromTriplets(entries.begin(), entries.end());
+    }
+
+    /**
+     * @brief The source and target compartments of all flows, in the order of Flows.
+     * @{
+     */
+    template <size_t... I>
+    static constexpr std::array<Comp, Flows::size()> get_flow_sources(std::index_sequence<I...>)
+    {
+        return {type_at_index_t<I, Flows>::source...};
+    }
+    template <size_t... I>
+    static constexpr std::array<Comp, Flows::size()> get_flow_targets(std::index_sequence<I...>)
+    {
+        return {type_at_index_t<I, Flows>::target...};
+    }
+    static constexpr std::array<Comp, Flows::size()> flow_sources =
+        get_flow_sources(std::make_index_sequence<Flows::size()>{});
+    static constexpr std::array<Comp, Flows::size()> flow_targets =
+        get_flow_targets(std::make_index_sequence<Flows::size()>{});
+    /** @} */
 
     /**
      * @brief Compute the derivatives of the compartments.
-     * Compute the derivatives/rhs of the model equations for a given flow and index.
+     * Compute the derivatives/rhs of the model equations for all flows of one FlowIndex.
      * Uses recursion, which is resolved at compile time depending on the Flows.
      * @param[in] flows Current change in flows, as computed by get_flows.
      * @param[out] rhs The derivatives of the model equations.
-     * @param[in, out] i The Popindex at which to compute derivative. The entry for Comp wll be overwritten.
+     * @param[in] flow_offset Flat flow index of the first flow of the FlowIndex.
+     * @param[in] population_offset Flat population index of the first compartment of the FlowIndex.
      * @tparam I The index of a flow in FlowChart.
      */
     template <size_t I = 0>
-    inline void get_rhs_impl(Eigen::Ref<const Eigen::VectorXd> flows, Eigen::Ref<Eigen::VectorXd> rhs,
-                             const FlowIndex& index) const
+    inline void get_rhs_impl(Eigen::Ref<const Vector<FP>> flows, Eigen::Ref<Vector<FP>> rhs,
+                             size_t flow_offset, size_t population_offset) const
     {
-        using Flow                 = type_at_index_t<I, Flows>;
-        const auto flat_flow_index = get_flat_flow_index<Flow::source, Flow::target>(index);
-        const auto flat_source_population =
-            this->populations.get_flat_index(extend_index<PopIndex>(index, (size_t)Flow::source));
-        const auto flat_target_population =
-            this->populations.get_flat_index(extend_index<PopIndex>(index, (size_t)Flow::target));
-        rhs[flat_source_population] -= flows[flat_flow_index]; // subtract outflow from source compartment
-        rhs[flat_target_population] += flows[flat_flow_index]; // add outflow to target compartment
+        using Flow             = type_at_index_t<I, Flows>;
+        const size_t stride    = compartments_are_consecutive ? 1 : m_compartment_stride;
+        const auto flat_source = population_offset + static_cast<size_t>(Flow::source) * stride;
+        const auto flat_target = population_offset + static_cast<size_t>(Flow::target) * stride;
+        rhs[flat_source] -= flows[flow_offset + I]; // subtract outflow from source compartment
+        rhs[flat_target] += flows[flow_offset + I]; // add outflow to target compartment
         // handle next flow (if there is one)
         if constexpr (I + 1 < Flows::size()) {
-            get_rhs_impl<I + 1>(flows, rhs, index);
+            get_rhs_impl<I + 1>(flows, rhs, flow_offset, population_offset);
         }
     }
 };
@@ -242,18 +409,19 @@ private:
  * @{
  */
 template <class M>
-using get_derivatives_expr_t = decltype(std::declval<const M&>().get_derivatives(
-    std::declval<Eigen::Ref<const Eigen::VectorXd>>(), std::declval<Eigen::Ref<Eigen::VectorXd>>()));
+using get_derivatives_expr_t =
+    decltype(std::declval<const M&>().get_derivatives(std::declval<Eigen::Ref<const Vector<model_scalar_t<M>>>>(),
+                                                      std::declval<Eigen::Ref<Vector<model_scalar_t<M>>>>()));
 
 template <class M>
-using get_flows_expr_t =
-    decltype(std::declval<const M&>().get_flows(std::declval<Eigen::Ref<const Eigen::VectorXd>>(),
-                                                std::declval<Eigen::Ref<const Eigen::VectorXd>>(),
-                                                std::declval<double>(), std::declval<Eigen::Ref<Eigen::VectorXd>>()));
+using get_flows_expr_t = decltype(std::declval<const M&>().get_flows(
+    std::declval<Eigen::Ref<const Vector<model_scalar_t<M>>>>(),
+    std::declval<Eigen::Ref<const Vector<model_scalar_t<M>>>>(), std::declval<double>(),
+    std::declval<Eigen::Ref<Vector<model_scalar_t<M>>>>()));
 
 template <class M>
 using get_initial_flows_expr_t =
-    decltype(std::declval<Eigen::VectorXd>() = std::declval<const M&>().get_initial_flows());
+    decltype(std::declval<Vector<model_scalar_t<M>>>() = std::declval<const M&>().get_initial_flows());
 /** @} */
 
 /**
@@ -32,8 +32,9 @@ class FlowSimulation : public Simulation<M>
     static_assert(is_flow_model<M>::value, "Template parameter must be a flow model.");
 
 public:
-    using Model = M;
-    using Base  = Simulation<M>;
+    using Model  = M;
+    using Base   = Simulation<M>;
+    using Scalar = typename Base::Scalar;
 
     /**
      * @brief Set up the simulation with an ODE solver.
@@ -44,6 +45,9 @@ public:
     FlowSimulation(Model const& model, double t0 = 0., double dt = 0.1)
         : Base(model, t0, dt)
         , m_pop(model.get_initial_values().size())
+        , m_flow_difference(model.get_initial_flows().size())
+        , m_flow_start(model.get_initial_flows().size())
+        , m_pop_start(model.get_initial_values().size())
         , m_flow_result(t0, model.get_initial_flows())
     {
     }
@@ -53,15 +57,19 @@ public:
      * tmax must be greater than get_result().get_last_time_point().
      * @param[in] tmax Next stopping time of the simulation.
      */
-    Eigen::Ref<Eigen::VectorXd> advance(double tmax)
+    Eigen::Ref<Vector<Scalar>> advance(double tmax)
     {
-        // the derivfunktion (i.e. the lambda passed to m_integrator.advance below) requires that there are at least
-        // as many entries in m_flow_result as in Base::m_result
-        assert(m_flow_result.get_num_time_points() == this->get_result().get_num_time_points());
-        auto result = this->get_ode_integrator().advance(
+        auto& pop_result = this->get_result();
+        assert(m_flow_result.get_num_time_points() == pop_result.get_num_time_points());
+        // the output policy may replace the last time point of the results during the integration, so the values at
+        // the start of the integration are copied
+        const auto num_time_points = pop_result.get_num_time_points();
+        const auto t_start         = pop_result.get_last_time();
+        m_flow_start               = m_flow_result.get_last_value();
+        m_pop_start                = pop_result.get_last_value();
+        auto result                = this->get_ode_integrator().advance(
             [this](auto&& flows, auto&& t, auto&& dflows_dt) {
-                const auto& pop_result = this->get_result();
-                const auto& model      = this->get_model();
+                const auto& model = this->get_model();
                 // compute current population
                 //   flows contains the accumulated outflows of each compartment for each target compartment at time t.
                 //   Using that the ODEs are linear expressions of the flows, get_derivatives can compute the total change
@@ -69,18 +77,22 @@ public:
                 //   To incorporate external changes to the last values of pop_result (e.g. by applying mobility), we only
                 //   calculate the change in population starting from the last available time point in m_result, instead
                 //   of starting at t0. To do that, the following difference of flows is used.
-                model.get_derivatives(flows - m_flow_result.get_value(pop_result.get_num_time_points() - 1),
-                                      m_pop); // note: overwrites values in pop
+                m_flow_difference = flows - m_flow_start;
+                model.get_derivatives(m_flow_difference, m_pop); // note: overwrites values in pop
                 //   add the "initial" value of the ODEs (using last available time point in pop_result)
                 //     If no changes were made to the last value in m_result outside of FlowSimulation, the following
                 //     line computes the same as `model.get_derivatives(flows, x); x += model.get_initial_values();`.
-                m_pop += pop_result.get_last_value();
+                m_pop += m_pop_start;
                 // compute the current change in flows with respect to the current population
                 dflows_dt.setZero();
                 model.get_flows(m_pop, m_pop, t, dflows_dt); // this result is used by the integrator
             },
-            tmax, this->get_dt(), m_flow_result);
-        compute_population_results();
+            tmax, this->get_dt(), m_flow_result, this->get_integrator_output());
+        if (m_flow_result.get_time(num_time_points - 1) != t_start) {
+            // the start of the integration was not on the output grid and has been replaced
+            pop_result.remove_last_time_point();
+        }
+        add_population_results();
         return result;
     }
 
@@ -94,12 +106,12 @@ public:
      * For each simulated time step, the TimeSeries contains the value of each flow. 
      * @{
      */
-    TimeSeries<ScalarType>& get_flows()
+    TimeSeries<Scalar>& get_flows()
     {
         return m_flow_result;
     }
 
-    const TimeSeries<ScalarType>& get_flows() const
+    const TimeSeries<Scalar>& get_flows() const
     {
         return m_flow_result;
     }
@@ -113,24 +125,38 @@ protected:
      * Does not recalculate older values.
      */
     void compute_population_results()
+    {
+        // take the last time point as base result (instead of the initial results), so that we use external changes
+        const auto last_tp = this->get_result().get_num_time_points() - 1;
+        m_flow_start       = get_flows().get_value(last_tp);
+        m_pop_start        = this->get_result().get_value(last_tp);
+        add_population_results();
+    }
+
+    Vector<Scalar> m_pop; ///< pre-allocated temporary, used in right_hand_side()
+    Vector<Scalar> m_flow_difference; ///< pre-allocated temporary, difference of the flows to the last time point
+    Vector<Scalar> m_flow_start; ///< flows at the start of the current integration
+    Vector<Scalar> m_pop_start; ///< population at the start of the current integration
+
+private:
+    /**
+     * @brief Adds time points to Base::m_result until it has the same number of time points as m_flow_result.
+     * The population is computed from the difference of the flows to m_flow_start and m_pop_start.
+     */
+    void add_population_results()
     {
         const auto& flows = get_flows();
         const auto& model = this->get_model();
         auto& result      = this->get_result();
-        // take the last time point as base result (instead of the initial results), so that we use external changes
-        const size_t last_tp = result.get_num_time_points() - 1;
-        // calculate new time points
         for (Eigen::Index i = result.get_num_time_points(); i < flows.get_num_time_points(); i++) {
             result.add_time_point(flows.get_time(i));
-            model.get_derivatives(flows.get_value(i) - flows.get_value(last_tp), result.get_value(i));
-            result.get_value(i) += result.get_value(last_tp);
+            m_flow_difference = flows.get_value(i) - m_flow_start;
+            model.get_derivatives(m_flow_difference, result.get_value(i));
+            result.get_value(i) += m_pop_start;
         }
     }
 
-    Eigen::VectorXd m_pop; ///< pre-allocated temporary, used in right_hand_side()
-
-private:
-    mio::TimeSeries<ScalarType> m_flow_result; ///< flow result of the simulation
+    mio::TimeSeries<Scalar> m_flow_result; ///< flow result of the simulation
 };
 
 /**
@@ -146,8 +172,9 @@ private:
  * @tparam Sim A FlowSimulation that can simulate the model.
  */
 template <class Model, class Sim = FlowSimulation<Model>>
-std::vector<TimeSeries<ScalarType>> simulate_flows(double t0, double tmax, double dt, Model const& model,
-                                                   std::shared_ptr<IntegratorCore> integrator = nullptr)
+std::vector<TimeSeries<model_scalar_t<Model>>>
+simulate_flows(double t0, double tmax, double dt, Model const& model,
+               std::shared_ptr<BasicIntegratorCore<model_scalar_t<Model>>> integrator = nullptr)
 {
     model.check_constraints();
     Sim sim(model, t0, dt);
@@ -23,26 +23,51 @@
 #include "memilio/config.h"
 #include "memilio/compartments/compartmentalmodel.h"
 #include "memilio/utils/metaprogramming.h"
+#include "memilio/math/adapt_rk.h"
 #include "memilio/math/stepper_wrapper.h"
 #include "memilio/utils/time_series.h"
 
+#include <type_traits>
+
 namespace mio
 {
 
 using DefaultIntegratorCore = mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_cash_karp54>;
 
+/**
+ * @brief The default integration scheme for states with entries of type FP.
+ * The boost steppers are only wrapped for double, other types use the Runge-Kutta-Fehlberg scheme.
+ */
+template <class FP>
+using BasicDefaultIntegratorCore =
+    std::conditional_t<std::is_same<FP, double>::value, DefaultIntegratorCore, BasicRKIntegratorCore<FP>>;
+
 /**
  * @brief A class for the simulation of a compartment model.
+ * By default, the integration scheme can be exchanged at runtime by set_integrator. If the integration scheme is
+ * given as template argument, the integrator calls the scheme and the right hand side of the model directly, see
+ * StaticOdeIntegrator. This is faster for small models, e.g. `Simulation<Model, DefaultIntegratorCore>`.
+ * The results have the same floating point type as the state of the model, see model_scalar_t.
  * @tparam M a CompartmentModel type
+ * @tparam Core BasicIntegratorCore for a runtime polymorphic integration scheme (default), or a type derived from
+ * BasicIntegratorCore to use this scheme without virtual calls.
  */
-template <class M>
+template <class M, class Core = BasicIntegratorCore<model_scalar_t<M>>>
 class Simulation
 {
+public:
+    using Model  = M;
+    using Scalar = model_scalar_t<M>;
+
+private:
     static_assert(is_compartment_model<M>::value, "Template parameter must be a compartment model.");
+    static_assert(std::is_base_of<BasicIntegratorCore<Scalar>, Core>::value, "Core must be an IntegratorCore.");
 
-public:
-    using Model = M;
+    static constexpr bool is_static_integrator = !std::is_same<Core, BasicIntegratorCore<Scalar>>::value;
+    using Integrator = std::conditional_t<is_static_integrator, StaticOdeIntegrator<Core>, BasicOdeIntegrator<Scalar>>;
+    using InitialIntegratorCore = std::conditional_t<is_static_integrator, Core, BasicDefaultIntegratorCore<Scalar>>;
 
+public:
     /**
      * @brief Setup the simulation with an ODE solver.
      * @param[in] model An instance of a compartmental model
@@ -50,7 +75,7 @@ public:
      * @param[in] dt Initial step size of integration
      */
     Simulation(Model const& model, double t0 = 0., double dt = 0.1)
-        : m_integratorCore(std::make_shared<DefaultIntegratorCore>())
+        : m_integratorCore(std::make_shared<InitialIntegratorCore>())
         , m_model(std::make_unique<Model>(model))
         , m_integrator(m_integratorCore)
         , m_result(t0, m_model->get_initial_values())
@@ -60,9 +85,9 @@ public:
 
     /**
      * @brief Set the integrator core used in the simulation.
-     * @param[in] integrator A shared pointer to an object derived from IntegratorCore.
+     * @param[in] integrator A shared pointer to an object derived from IntegratorCore, or of type Core.
      */
-    void set_integrator(std::shared_ptr<IntegratorCore> integrator)
+    void set_integrator(std::shared_ptr<Core> integrator)
     {
         m_integratorCore = std::move(integrator);
         m_integrator.set_integrator(m_integratorCore);
@@ -73,29 +98,53 @@ public:
      * @return A reference to the integrator core used in the simulation
      * @{
      */
-    IntegratorCore& get_integrator()
+    Core& get_integrator()
     {
         return *m_integratorCore;
     }
 
-    IntegratorCore const& get_integrator() const
+    Core const& get_integrator() const
     {
         return *m_integratorCore;
     }
     /** @} */
 
+    /**
+     * @brief Select the time points that are stored in the result.
+     * By default, the result contains every integration step. Storing only the last step of each call to advance or
+     * the values on an equidistant grid reduces the memory of long simulations with adaptive integrators.
+     * The grid starts at the first time point of the result. The last time point of the result is always the current
+     * state of the simulation. With OutputPolicy::Grid it is replaced by the next call to advance if it is not on the
+     * grid, so the result does not keep the states at the stopping points of a graph simulation, which are needed by
+     * the returns of a MigrationEdge, unless they are on the grid.
+     * @param[in] policy Which time points are stored.
+     * @param[in] dt_grid Distance of the grid points, only used with OutputPolicy::Grid.
+     */
+    void set_output_policy(OutputPolicy policy, double dt_grid = 1.0)
+    {
+        m_output = IntegratorOutput<Scalar>(policy, m_result.get_time(0), dt_grid);
+    }
+
+    /**
+     * @brief Get the policy that selects the time points that are stored in the result.
+     */
+    OutputPolicy get_output_policy() const
+    {
+        return m_output.get_policy();
+    }
+
     /**
      * @brief advance simulation to tmax
      * tmax must be greater than get_result().get_last_time_point()
      * @param tmax next stopping point of simulation
      */
-    Eigen::Ref<Eigen::VectorXd> advance(double tmax)
+    Eigen::Ref<Vector<Scalar>> advance(double tmax)
     {
         return m_integrator.advance(
             [this](auto&& y, auto&& t, auto&& dydt) {
                 get_model().eval_right_hand_side(y, y, t, dydt);
             },
-            tmax, m_dt, m_result);
+            tmax, m_dt, m_result, m_output);
     }
 
     /**
@@ -108,12 +157,12 @@ public:
      * For each simulated time step, the TimeSeries contains the population size in each compartment.
      * @{
      */
-    TimeSeries<ScalarType>& get_result()
+    TimeSeries<Scalar>& get_result()
     {
         return m_result;
     }
 
-    const TimeSeries<ScalarType>& get_result() const
+    const TimeSeries<Scalar>& get_result() const
     {
         return m_result;
     }
@@ -154,16 +203,23 @@ public:
 
 protected:
     /// @brief Get a reference to the integrater. Can be used to overwrite advance.
-    OdeIntegrator& get_ode_integrator()
+    Integrator& get_ode_integrator()
     {
         return m_integrator;
     }
 
+    /// @brief Get a reference to the output that selects the stored time points, see set_output_policy.
+    IntegratorOutput<Scalar>& get_integrator_output()
+    {
+        return m_output;
+    }
+
 private:
-    std::shared_ptr<IntegratorCore> m_integratorCore; ///< Defines the integration scheme via its step function.
+    std::shared_ptr<Core> m_integratorCore; ///< Defines the integration scheme via its step function.
     std::unique_ptr<Model> m_model; ///< The model defining the ODE system and initial conditions.
-    OdeIntegrator m_integrator; ///< Integrates the DerivFunction (see advance) and stores resutls in m_result.
-    TimeSeries<ScalarType> m_result; ///< The simulation results.
+    Integrator m_integrator; ///< Integrates the DerivFunction (see advance) and stores resutls in m_result.
+    TimeSeries<Scalar> m_result; ///< The simulation results.
+    IntegratorOutput<Scalar> m_output; ///< Selects the time points that are stored in m_result.
     ScalarType m_dt; ///< The time step used (and possibly set) by m_integratorCore::step.
 };
 
@@ -199,8 +255,9 @@ using is_compartment_model_simulation =
  * @tparam Sim A Simulation that can simulate the model.
  */
 template <class Model, class Sim = Simulation<Model>>
-TimeSeries<ScalarType> simulate(double t0, double tmax, double dt, Model const& model,
-                                std::shared_ptr<IntegratorCore> integrator = nullptr)
+TimeSeries<model_scalar_t<Model>>
+simulate(double t0, double tmax, double dt, Model const& model,
+         std::shared_ptr<BasicIntegratorCore<model_scalar_t<Model>>> integrator = nullptr)
 {
     model.check_constraints();
     Sim sim(model, t0, dt);
@@ -18,7 +18,6 @@
 * limitations under the License.
 */
 #include "memilio/data/analyze_result.h"
-#include "memilio/math/interpolation.h"
 
 #include <algorithm>
 #include <cassert>
@@ -62,40 +61,12 @@ TimeSeries<double> interpolate_simulation_result(const TimeSeries<double>& simul
         return interpolated;
     }
 
-    size_t interp_idx = 0;
-    // add first time point of interpolation times in case it is smaller than the first time point of simulation_result
-    // this is used for the case that it equals the first time point of simulation up to tolerance
-    // this is necessary even if the tolerance is 0 due to the way the comparison in the loop is implemented (< and >=)
-    if (simulation_result.get_time(0) >= interpolation_times[0]) {
-        interpolated.add_time_point(interpolation_times[0], simulation_result[0]);
-        ++interp_idx;
-    }
-
-    //interpolate between pair of time points that lie on either side of each interpolation point
-    for (Eigen::Index sim_idx = 0;
-         sim_idx < simulation_result.get_num_time_points() - 1 && interp_idx < interpolation_times.size();) {
-        //only go to next pair of time points if no time point is added.
-        //otherwise check the same time points again
-        //in case there is more than one interpolation point between the two time points
-        if (simulation_result.get_time(sim_idx) < interpolation_times[interp_idx] &&
-            simulation_result.get_time(sim_idx + 1) >= interpolation_times[interp_idx]) {
-            interpolated.add_time_point(
-                interpolation_times[interp_idx],
-                linear_interpolation(interpolation_times[interp_idx], simulation_result.get_time(sim_idx),
-                                     simulation_result.get_time(sim_idx + 1), simulation_result[sim_idx],
-                                     simulation_result[sim_idx + 1]));
-            ++interp_idx;
-        }
-        else {
-            ++sim_idx;
-        }
-    }
-
-    // add last time point of interpolation times in case it is larger than the last time point of simulation_result
-    // this is used for the case that it equals the last time point of simulation up to tolerance
-    if (interp_idx < interpolation_times.size() &&
-        simulation_result.get_last_time() < interpolation_times[interp_idx]) {
-        interpolated.add_time_point(interpolation_times[interp_idx], simulation_result.get_last_value());
+    // the first and the last interpolation time may lie outside of the simulation times up to a tolerance,
+    // the values at these times are the first and the last value of the simulation result
+    interpolated.reserve(Eigen::Index(interpolation_times.size()));
+    for (auto t : interpolation_times) {
+        interpolated.add_time_point(t);
+        simulation_result.interpolate(t, interpolated.get_last_value());
     }
 
     return interpolated;
@@ -161,17 +132,21 @@ std::vector<TimeSeries<double>> ensemble_percentile(const std::vector<std::vecto
 
     std::vector<TimeSeries<double>> percentile(num_nodes, TimeSeries<double>::zero(num_time_points, num_elements));
 
-    std::vector<double> single_element_ensemble(num_runs); //reused for each element
+    //values of all runs at one time point, one column per element, so the values of an element are contiguous
+    Eigen::MatrixXd single_time_ensemble(num_runs, num_elements); //reused for each node and time point
+    auto idx_percentile = static_cast<Eigen::Index>(num_runs * p);
     for (size_t node = 0; node < num_nodes; node++) {
         for (Eigen::Index time = 0; time < num_time_points; time++) {
             percentile[node].get_time(time) = ensemble_result[0][node].get_time(time);
+            for (size_t run = 0; run < num_runs; run++) {
+                single_time_ensemble.row(Eigen::Index(run)) = ensemble_result[run][node][time].transpose();
+            }
             for (Eigen::Index elem = 0; elem < num_elements; elem++) {
-                std::transform(ensemble_result.begin(), ensemble_result.end(), single_element_ensemble.begin(),
-                               [=](auto& run) {
-                                   return run[node][time][elem];
-                               });
-                std::sort(single_element_ensemble.begin(), single_element_ensemble.end());
-                percentile[node][time][elem] = single_element_ensemble[static_cast<size_t>(num_runs * p)];
+                //partial sort is enough to find the element at the percentile
+                auto single_element_ensemble = single_time_ensemble.col(elem).data();
+                std::nth_element(single_element_ensemble, single_element_ensemble + idx_percentile,
+                                 single_element_ensemble + num_runs);
+                percentile[node][time][elem] = single_element_ensemble[idx_percentile];
             }
         }
     }
@@ -24,6 +24,11 @@
 #include "memilio/epidemiology/damping.h"
 #include "memilio/utils/stl_util.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <numeric>
 #include <ostream>
@@ -194,6 +199,19 @@ public:
         return get_matrix_at(SimulationTime(t));
     }
 
+    /**
+     * Get the time interval around a point in time where the matrix does not change.
+     * @see Dampings::get_constant_interval
+     */
+    std::pair<double, double> get_constant_interval(SimulationTime t) const
+    {
+        return m_dampings.get_constant_interval(t);
+    }
+    std::pair<double, double> get_constant_interval(double t) const
+    {
+        return get_constant_interval(SimulationTime(t));
+    }
+
     /**
      * gtest printer.
      */
@@ -263,6 +281,100 @@ private:
     DampingsType m_dampings;
 };
 
+/**
+ * cache of matrices that are evaluated at points in time.
+ * Every entry is valid on a time interval, e.g. between two changes of dampings.
+ * If the cache is full, the least recently used entry is replaced.
+ * Access is synchronized, so the cache can be shared by multiple objects that evaluate the same matrices.
+ * @tparam M matrix type.
+ */
+template <class M>
+class TimeIntervalMatrixCache
+{
+public:
+    /**
+     * create an empty cache.
+     * @param capacity maximum number of cached matrices, 0 disables the cache.
+     */
+    explicit TimeIntervalMatrixCache(size_t capacity)
+        : m_capacity(capacity)
+    {
+        m_entries.reserve(capacity);
+    }
+
+    /**
+     * get the maximum number of cached matrices.
+     */
+    size_t get_capacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * get the number of cached matrices.
+     */
+    size_t get_num_entries() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+
+    /**
+     * copy the cached matrix that is valid at a point in time.
+     * @param t point in time.
+     * @param[out] result cached matrix, unchanged if no matrix is found.
+     * @return true if a matrix is found, false otherwise.
+     */
+    bool find(double t, M& result)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& entry : m_entries) {
+            if (entry.t_begin <= t && t <= entry.t_end) {
+                entry.last_use = ++m_num_uses;
+                result         = entry.matrix;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * add a matrix to the cache.
+     * @param t_begin first point in time where the matrix is valid.
+     * @param t_end last point in time where the matrix is valid.
+     * @param matrix the matrix.
+     */
+    void insert(double t_begin, double t_end, const M& matrix)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_entries.size() < m_capacity) {
+            m_entries.push_back({t_begin, t_end, matrix, ++m_num_uses});
+        }
+        else if (m_capacity > 0) {
+            auto lru = std::min_element(m_entries.begin(), m_entries.end(), [](auto& e1, auto& e2) {
+                return e1.last_use < e2.last_use;
+            });
+            //assign the members to reuse the memory of the matrix
+            lru->t_begin  = t_begin;
+            lru->t_end    = t_end;
+            lru->matrix   = matrix;
+            lru->last_use = ++m_num_uses;
+        }
+    }
+
+private:
+    struct Entry {
+        double t_begin;
+        double t_end;
+        M matrix;
+        uint64_t last_use;
+    };
+    mutable std::mutex m_mutex;
+    size_t m_capacity;
+    uint64_t m_num_uses = 0;
+    std::vector<Entry> m_entries;
+};
+
 /**
  * represents a collection of DampingMatrixExpressions that are summed up.
  * @tparam E some instance of DampingMatrixExpression or compatible type.
@@ -309,11 +421,40 @@ public:
         assert(v.size() > 0);
     }
 
+    /**
+     * copies start with an empty cache, see share_cache.
+     */
+    DampingMatrixExpressionGroup(const DampingMatrixExpressionGroup& other)
+        : m_matrices(other.m_matrices)
+        , m_cache(std::make_shared<Cache>(other.m_cache->get_capacity()))
+    {
+    }
+    DampingMatrixExpressionGroup& operator=(const DampingMatrixExpressionGroup& other)
+    {
+        m_matrices = other.m_matrices;
+        m_cache    = std::make_shared<Cache>(other.m_cache->get_capacity());
+        return *this;
+    }
+    DampingMatrixExpressionGroup(DampingMatrixExpressionGroup&& other)
+        : m_matrices(std::move(other.m_matrices))
+        , m_cache(other.m_cache)
+    {
+    }
+    DampingMatrixExpressionGroup& operator=(DampingMatrixExpressionGroup&& other)
+    {
+        m_matrices = std::move(other.m_matrices);
+        m_cache    = other.m_cache;
+        return *this;
+    }
+
     /**
      * access one matrix.
+     * The matrix may be changed, so the cache of evaluated matrices is cleared.
+     * Don't keep the reference to change the matrix after evaluating the group.
      */
     reference operator[](size_t i)
     {
+        invalidate_cache();
         return m_matrices[i];
     }
     const_reference operator[](size_t i) const
@@ -356,7 +497,8 @@ public:
     template <class... T>
     void add_damping(T&&... t)
     {
-        for (auto& m : *this) {
+        invalidate_cache();
+        for (auto& m : m_matrices) {
             m.add_damping(std::forward<T>(t)...);
         }
     }
@@ -366,7 +508,8 @@ public:
      */
     void clear_dampings()
     {
-        for (auto& m : *this) {
+        invalidate_cache();
+        for (auto& m : m_matrices) {
             m.clear_dampings();
         }
     }
@@ -377,7 +520,8 @@ public:
      */
     void set_automatic_cache_update(bool b)
     {
-        for (auto& m : *this) {
+        invalidate_cache();
+        for (auto& m : m_matrices) {
             m.set_automatic_cache_update(b);
         }
     }
@@ -399,15 +543,83 @@ public:
             });
     }
 
+    /**
+     * evaluate the real contact frequency at a point in time into a matrix.
+     * sum of all contained matrices.
+     * Every matrix and its dampings are evaluated only once, while every coefficient access
+     * of the expression returned by get_matrix_at(t) evaluates all matrices again.
+     * Use this if more than a few coefficients are needed.
+     * The matrix is constant between changes of the dampings, so evaluated matrices are cached
+     * and reused as long as the group is not changed, see set_cache_capacity and share_cache.
+     * @param t point in time
+     * @param[out] result matrix of size num_groups x num_groups, resized if necessary.
+     */
+    template <class T>
+    void get_matrix_at(T t, Matrix& result) const
+    {
+        //the matrix doesn't change between transitions of the dampings, so it can be reused e.g. by later stages
+        //of an integrator step
+        if (m_cache->find(double(t), result)) {
+            return;
+        }
+        result.setZero(get_shape().rows(), get_shape().cols());
+        auto t_begin = std::numeric_limits<double>::lowest();
+        auto t_end   = std::numeric_limits<double>::max();
+        for (auto& m : m_matrices) {
+            result += m.get_matrix_at(t);
+            auto interval = m.get_constant_interval(t);
+            t_begin       = std::max(t_begin, interval.first);
+            t_end         = std::min(t_end, interval.second);
+        }
+        m_cache->insert(t_begin, t_end, result);
+    }
+
+    /**
+     * set the number of matrices that are cached by get_matrix_at(t, result).
+     * Clears the cache.
+     * @param capacity maximum number of cached matrices, 0 disables the cache.
+     */
+    void set_cache_capacity(size_t capacity)
+    {
+        m_cache = std::make_shared<Cache>(capacity);
+    }
+
+    /**
+     * get the cache of matrices evaluated by get_matrix_at(t, result).
+     */
+    const TimeIntervalMatrixCache<Matrix>& get_cache() const
+    {
+        return *m_cache;
+    }
+
+    /**
+     * use the same cache of evaluated matrices as another group with equal matrices.
+     * E.g. the contact matrices of all nodes of a graph are often equal, so the matrix
+     * is only evaluated once for all nodes.
+     * The cache is not shared anymore if one of the groups is changed.
+     * @param other group to share the cache with.
+     * @return true if the cache is shared, false if the groups are not equal.
+     */
+    bool share_cache(const DampingMatrixExpressionGroup& other)
+    {
+        if (*this != other) {
+            return false;
+        }
+        m_cache = other.m_cache;
+        return true;
+    }
+
     /**
      * STL iterators over matrices.
      */
     iterator begin()
     {
+        invalidate_cache();
         return m_matrices.begin();
     }
     iterator end()
     {
+        invalidate_cache();
         return m_matrices.end();
     }
     const_iterator begin() const
@@ -483,8 +695,26 @@ public:
         return deserialize(io, Tag<DampingMatrixExpressionGroup>{});
     }
 
+    /**
+     * default number of matrices cached by get_matrix_at(t, result).
+     */
+    static constexpr size_t DEFAULT_CACHE_CAPACITY = 4;
+
 private:
+    using Cache = TimeIntervalMatrixCache<Matrix>;
+
+    /**
+     * stop using the cache of evaluated matrices because the matrices may change.
+     */
+    void invalidate_cache()
+    {
+        if (m_cache.use_count() > 1 || m_cache->get_num_entries() > 0) {
+            m_cache = std::make_shared<Cache>(m_cache->get_capacity());
+        }
+    }
+
     std::vector<value_type> m_matrices;
+    std::shared_ptr<Cache> m_cache = std::make_shared<Cache>(DEFAULT_CACHE_CAPACITY);
 };
 
 /**
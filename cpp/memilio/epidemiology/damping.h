@@ -29,6 +29,7 @@
 #include "memilio/math/floating_point.h"
 
 #include <tuple>
+#include <utility>
 #include <vector>
 #include <algorithm>
 #include <ostream>
@@ -310,6 +311,7 @@ public:
     {
         assert(m_dampings.size() > i);
         m_dampings.erase(m_dampings.begin() + i);
+        m_accumulated_dampings_cached.clear();
         automatic_cache_update();
     }
 
@@ -319,6 +321,7 @@ public:
     void clear()
     {
         m_dampings.clear();
+        m_accumulated_dampings_cached.clear();
         automatic_cache_update();
     }
 
@@ -368,6 +371,34 @@ public:
         return get_matrix_at(SimulationTime(t));
     }
 
+    /**
+     * Get the time interval around a point in time where the real contact frequency does not change.
+     * The real contact frequency is constant between the smoothed transitions of get_matrix_at().
+     * @param t time in the simulation
+     * @return interval [a, b] that contains t so that get_matrix_at() is equal for all points in time in the interval.
+     * [t, t] if t is inside of a transition.
+     */
+    std::pair<double, double> get_constant_interval(SimulationTime t) const
+    {
+        assert(!m_accumulated_dampings_cached.empty() && "Cache is not current. Did you disable the automatic cache update?");
+        auto ub =
+            std::upper_bound(m_accumulated_dampings_cached.begin(), m_accumulated_dampings_cached.end(),
+                             std::make_tuple(t), [](auto&& tup1, auto&& tup2) {
+                                 return double(std::get<SimulationTime>(tup1)) < double(std::get<SimulationTime>(tup2));
+                             });
+        //the transition to the next value starts one day before the next damping, see smoother_cosine
+        auto t_begin = double(std::get<SimulationTime>(*(ub - 1)));
+        auto t_end   = double(std::get<SimulationTime>(*ub)) - 1;
+        if (double(t) <= t_end) {
+            return {t_begin, t_end};
+        }
+        return {double(t), double(t)};
+    }
+    std::pair<double, double> get_constant_interval(double t) const
+    {
+        return get_constant_interval(SimulationTime(t));
+    }
+
     /**
      * access one damping in this collection.
      */
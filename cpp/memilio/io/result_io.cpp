@@ -65,12 +65,9 @@ IOResult<void> save_result(const std::vector<TimeSeries<double>>& results, const
                              num_timepoints, num_infectionstates)
                              .eval();
             if (group_idx < num_groups) {
-                for (Eigen::Index t_idx = 0; t_idx < result.get_num_time_points(); ++t_idx) {
-                    auto v           = result[t_idx].transpose().eval();
-                    auto group_slice = mio::slice(v, {group_idx * num_infectionstates, num_infectionstates});
-                    mio::slice(group, {t_idx, 1}, {0, num_infectionstates}) = group_slice;
-                    mio::slice(total, {t_idx, 1}, {0, num_infectionstates}) += group_slice;
-                }
+                //the values of one group at all time points are a block of the transposed result
+                group = result.values_by_time().middleCols(group_idx * num_infectionstates, num_infectionstates);
+                total += group;
             }
 
             hsize_t dims_values[] = {static_cast<hsize_t>(num_timepoints), static_cast<hsize_t>(num_infectionstates)};
@@ -160,8 +157,9 @@ IOResult<std::vector<SimulationResult>> read_result(const std::string& filename)
         auto totals = TimeSeries<double>(num_infectionstates);
         totals.reserve(num_timepoints);
         for (auto t_idx = 0; t_idx < num_timepoints; ++t_idx) {
-            totals.add_time_point(time[t_idx], slice(total_values, {t_idx, 1}, {0, num_infectionstates}).transpose());
+            totals.add_time_point(time[t_idx]);
         }
+        totals.values_by_time() = total_values;
 
         auto groups = TimeSeries<double>(num_infectionstates * num_groups);
         groups.reserve(num_timepoints);
@@ -192,11 +190,7 @@ IOResult<std::vector<SimulationResult>> read_result(const std::string& filename)
                 H5Dread(dataset_values.id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, group_values.data()),
                 StatusCode::UnknownError, "Values data could not be read");
 
-            for (Eigen::Index idx_t = 0; idx_t < num_timepoints; idx_t++) {
-                for (Eigen::Index idx_c = 0; idx_c < num_infectionstates; idx_c++) {
-                    groups[idx_t][num_infectionstates * group_idx + idx_c] = group_values(idx_t, idx_c);
-                }
-            }
+            groups.values_by_time().middleCols(num_infectionstates * group_idx, num_infectionstates) = group_values;
         }
 
         results.push_back(SimulationResult(groups, totals));
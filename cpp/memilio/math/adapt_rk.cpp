@@ -71,83 +71,4 @@ Tableau::Tableau()
     entries[4][5] = -11 / 40.0;
 }
 
-bool RKIntegratorCore::step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t, double& dt,
-                            Eigen::Ref<Eigen::VectorXd> ytp1) const
-{
-    assert(0 <= m_dt_min);
-    assert(m_dt_min <= m_dt_max);
-
-    if (dt < m_dt_min || dt > m_dt_max) {
-        mio::log_warning("IntegratorCore: Restricting given step size dt = {} to [{}, {}].", dt, m_dt_min, m_dt_max);
-    }
-
-    dt = std::min(dt, m_dt_max);
-
-    double t_eval; // shifted time for evaluating yt
-    double dt_new; // updated dt
-
-    bool converged     = false; // carry for convergence criterion
-    bool dt_is_invalid = false;
-
-    if (m_yt_eval.size() != yt.size()) {
-        m_yt_eval.resize(yt.size());
-        m_kt_values.resize(yt.size(), m_tab_final.entries_low.size());
-    }
-
-    m_yt_eval = yt;
-
-    while (!converged && !dt_is_invalid) {
-        if (dt < m_dt_min) {
-            dt_is_invalid = true;
-            dt            = m_dt_min;
-        }
-        // compute first column of kt, i.e. kt_0 for each y in yt_eval
-        f(m_yt_eval, t, m_kt_values.col(0));
-
-        for (Eigen::Index i = 1; i < m_kt_values.cols(); i++) {
-            // we first compute k_n1 for each y_j, then k_n2 for each y_j, etc.
-            t_eval = t;
-            t_eval += m_tab.entries[i - 1][0] *
-                      dt; // t_eval = t + c_i * h // note: line zero of Butcher tableau not stored in array
-            // use ytp1 as temporary storage for evaluating m_kt_values[i]
-            ytp1 = m_yt_eval;
-            for (Eigen::VectorXd::Index k = 1; k < m_tab.entries[i - 1].size(); k++) {
-                ytp1 += (dt * m_tab.entries[i - 1][k]) * m_kt_values.col(k - 1);
-            }
-            // get the derivatives, i.e., compute kt_i for all y in ytp1: kt_i = f(t_eval, ytp1_low)
-            f(ytp1, t_eval, m_kt_values.col(i));
-        }
-        // calculate low order estimate
-        ytp1 = m_yt_eval;
-        ytp1 += (dt * (m_kt_values * m_tab_final.entries_low));
-        // truncation error estimate: yt_low - yt_high = O(h^(p+1)) where p = order of convergence
-        m_error_estimate = dt * (m_kt_values * (m_tab_final.entries_high - m_tab_final.entries_low)).array().abs();
-        // calculate mixed tolerance
-        m_eps = m_abs_tol + ytp1.array().abs() * m_rel_tol;
-
-        converged = (m_error_estimate <= m_eps).all(); // convergence criterion
-
-        if (converged || dt_is_invalid) {
-            // if sufficiently exact, return ytp1, which currently contains the lower order approximation
-            // (higher order is not always higher accuracy)
-            t += dt; // this is the t where ytp1 belongs to
-        }
-        // else: repeat the calculation above (with updated dt)
-
-        // compute new value for dt
-        // converged implies eps/error_estimate >= 1, so dt will be increased for the next step
-        // hence !converged implies 0 < eps/error_estimate < 1, strictly decreasing dt
-        dt_new = dt * std::pow((m_eps / m_error_estimate).minCoeff(), (1. / (m_tab_final.entries_low.size() - 1)));
-        // safety factor for more conservative step increases,
-        // and to avoid dt_new -> dt for step decreases when |error_estimate - eps| -> 0
-        dt_new *= 0.9;
-        // check if updated dt stays within desired bounds and update dt for next step
-        dt = std::min(dt_new, m_dt_max);
-    }
-    dt = std::max(dt, m_dt_min);
-    // return 'converged' in favor of '!dt_is_invalid', as these values only differ if step sizing failed,
-    // but the step with size dt_min was accepted.
-    return converged;
-}
-
 } // namespace mio
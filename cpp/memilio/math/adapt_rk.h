@@ -21,6 +21,7 @@
 #define ADAPT_RK_H_
 
 #include "memilio/math/integrator.h"
+#include "memilio/utils/logging.h"
 
 #include <cstdio>
 #include <vector>
@@ -95,14 +96,17 @@ public:
  * @brief Two scheme Runge-Kutta numerical integrator with adaptive step width
  *
  * This class integrates a system of ODEs via the step method
+ * The tableaus and tolerances are stored as double, the stages and the error estimate use the type FP of the state.
+ * @tparam FP Floating point type of the entries of the state y.
  */
-class RKIntegratorCore : public IntegratorCore
+template <class FP>
+class BasicRKIntegratorCore : public BasicIntegratorCore<FP>
 {
 public:
     /**
      * @brief Setting up the integrator
      */
-    RKIntegratorCore()
+    BasicRKIntegratorCore()
         : m_abs_tol(1e-10)
         , m_rel_tol(1e-5)
         , m_dt_min(std::numeric_limits<double>::min())
@@ -117,7 +121,7 @@ public:
      * @param dt_min lower bound for time step dt
      * @param dt_max upper bound for time step dt
      */
-    RKIntegratorCore(const double abs_tol, const double rel_tol, const double dt_min, const double dt_max)
+    BasicRKIntegratorCore(const double abs_tol, const double rel_tol, const double dt_min, const double dt_max)
         : m_abs_tol(abs_tol)
         , m_rel_tol(rel_tol)
         , m_dt_min(dt_min)
@@ -164,21 +168,124 @@ public:
      * @param[in,out] dt current time step size h=dt
      * @param[out] ytp1 approximated value y(t+1)
      */
-    bool step(const DerivFunction& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t, double& dt,
-              Eigen::Ref<Eigen::VectorXd> ytp1) const override;
+    bool step(const BasicDerivFunction<FP>& f, Eigen::Ref<Vector<FP> const> yt, double& t, double& dt,
+              Eigen::Ref<Vector<FP>> ytp1) const override
+    {
+        return step_static(f, yt, t, dt, ytp1);
+    }
+
+    /**
+     * @brief Make a single integration step of a system of ODEs and adapt the step size, for any type of right hand
+     * side f.
+     * @see step(const BasicDerivFunction<FP>&, Eigen::Ref<Vector<FP> const>, double&, double&, Eigen::Ref<Vector<FP>>)
+     */
+    template <class F>
+    bool step_static(const F& f, Eigen::Ref<Vector<FP> const> yt, double& t, double& dt,
+              Eigen::Ref<Vector<FP>> ytp1) const
+    {
+        assert(0 <= m_dt_min);
+        assert(m_dt_min <= m_dt_max);
+
+        if (dt < m_dt_min || dt > m_dt_max) {
+            mio::log_warning("IntegratorCore: Restricting given step size dt = {} to [{}, {}].", dt, m_dt_min,
+                             m_dt_max);
+        }
+
+        dt = std::min(dt, m_dt_max);
+
+        double t_eval; // shifted time for evaluating yt
+        double dt_new; // updated dt
+
+        bool converged     = false; // carry for convergence criterion
+        bool dt_is_invalid = false;
+
+        if (m_yt_eval.size() != yt.size()) {
+            m_yt_eval.resize(yt.size());
+            m_kt_values.resize(yt.size(), m_tab_final.entries_low.size());
+            m_error_difference.resize(yt.size());
+        }
+
+        m_yt_eval = yt;
+        // coefficients of the final rows in the type of the state, the assignments do not allocate after the first step
+        m_entries_low        = m_tab_final.entries_low.template cast<FP>();
+        m_entries_difference = (m_tab_final.entries_high - m_tab_final.entries_low).template cast<FP>();
+
+        while (!converged && !dt_is_invalid) {
+            if (dt < m_dt_min) {
+                dt_is_invalid = true;
+                dt            = m_dt_min;
+            }
+            // compute first column of kt, i.e. kt_0 for each y in yt_eval
+            f(m_yt_eval, t, m_kt_values.col(0));
+
+            for (Eigen::Index i = 1; i < m_kt_values.cols(); i++) {
+                // we first compute k_n1 for each y_j, then k_n2 for each y_j, etc.
+                t_eval = t;
+                t_eval += m_tab.entries[i - 1][0] *
+                          dt; // t_eval = t + c_i * h // note: line zero of Butcher tableau not stored in array
+                // use ytp1 as temporary storage for evaluating m_kt_values[i]
+                ytp1 = m_yt_eval;
+                for (Eigen::Index k = 1; k < m_tab.entries[i - 1].size(); k++) {
+                    ytp1 += FP(dt * m_tab.entries[i - 1][k]) * m_kt_values.col(k - 1);
+                }
+                // get the derivatives, i.e., compute kt_i for all y in ytp1: kt_i = f(t_eval, ytp1_low)
+                f(ytp1, t_eval, m_kt_values.col(i));
+            }
+            // calculate low order estimate
+            ytp1 = m_yt_eval;
+            ytp1.noalias() += FP(dt) * (m_kt_values * m_entries_low);
+            // truncation error estimate: yt_low - yt_high = O(h^(p+1)) where p = order of convergence
+            // products are evaluated into preallocated vectors to avoid heap allocations
+            m_error_difference.noalias() = m_kt_values * m_entries_difference;
+            m_error_estimate             = FP(dt) * m_error_difference.array().abs();
+            // calculate mixed tolerance
+            m_eps = FP(m_abs_tol) + ytp1.array().abs() * FP(m_rel_tol);
+
+            converged = (m_error_estimate <= m_eps).all(); // convergence criterion
+
+            if (converged || dt_is_invalid) {
+                // if sufficiently exact, return ytp1, which currently contains the lower order approximation
+                // (higher order is not always higher accuracy)
+                t += dt; // this is the t where ytp1 belongs to
+            }
+            // else: repeat the calculation above (with updated dt)
+
+            // compute new value for dt
+            // converged implies eps/error_estimate >= 1, so dt will be increased for the next step
+            // hence !converged implies 0 < eps/error_estimate < 1, strictly decreasing dt
+            dt_new = dt * std::pow(double((m_eps / m_error_estimate).minCoeff()),
+                                   (1. / (m_tab_final.entries_low.size() - 1)));
+            // safety factor for more conservative step increases,
+            // and to avoid dt_new -> dt for step decreases when |error_estimate - eps| -> 0
+            dt_new *= 0.9;
+            // check if updated dt stays within desired bounds and update dt for next step
+            dt = std::min(dt_new, m_dt_max);
+        }
+        dt = std::max(dt, m_dt_min);
+        // return 'converged' in favor of '!dt_is_invalid', as these values only differ if step sizing failed,
+        // but the step with size dt_min was accepted.
+        return converged;
+    }
 
 protected:
     Tableau m_tab;
     TableauFinal m_tab_final;
     double m_abs_tol, m_rel_tol;
     double m_dt_min, m_dt_max;
-    mutable Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> m_kt_values;
-    mutable Eigen::VectorXd m_yt_eval;
+    mutable Eigen::Matrix<FP, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> m_kt_values;
+    mutable Vector<FP> m_yt_eval;
 
 private:
-    mutable Eigen::ArrayXd m_eps, m_error_estimate; // tolerance and estimate used for time step adaption
+    // tolerance and estimate used for time step adaption
+    mutable Eigen::Array<FP, Eigen::Dynamic, 1> m_eps, m_error_estimate;
+    mutable Vector<FP> m_entries_low, m_entries_difference, m_error_difference; // temporaries of the error estimate
 };
 
+/**
+ * @brief Two scheme Runge-Kutta numerical integrator with adaptive step width for states of type Eigen::VectorXd.
+ */
+using RKIntegratorCore = BasicRKIntegratorCore<double>;
+
 } // namespace mio
 
 #endif // ADAPT_RK_H_
@@ -0,0 +1,63 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/math/dormand_prince.h"
+
+namespace mio
+{
+
+const Eigen::Matrix<double, 7, 1>& DormandPrinceIntegratorCore::error_coefficients()
+{
+    static const Eigen::Matrix<double, 7, 1> e = (Eigen::Matrix<double, 7, 1>() << 71. / 57600, 0., -71. / 16695,
+                                                  71. / 1920, -17253. / 339200, 22. / 525, -1. / 40)
+                                                     .finished();
+    return e;
+}
+
+const Eigen::Matrix<double, 7, 1>& DormandPrinceIntegratorCore::dense_coefficients()
+{
+    static const Eigen::Matrix<double, 7, 1> d =
+        (Eigen::Matrix<double, 7, 1>() << -12715105075. / 11282082432, 0., 87487479700. / 32700410799,
+         -10690763975. / 1880347072, 701980252875. / 199316789632, -1453857185. / 822651844, 69997945. / 29380423)
+            .finished();
+    return d;
+}
+
+bool DormandPrinceIntegratorCore::step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t,
+                                       double& dt, Eigen::Ref<Eigen::VectorXd> ytp1) const
+{
+    return step_static(f, yt, t, dt, ytp1);
+}
+
+void DormandPrinceIntegratorCore::interpolate(double t, Eigen::Ref<Eigen::VectorXd> y) const
+{
+    assert(m_dt_last > 0 && "No step was made yet.");
+    assert(m_t_last <= t && t <= m_t_last + m_dt_last * (1 + 1e-10));
+    const auto h      = m_dt_last;
+    const auto theta  = (t - m_t_last) / h;
+    const auto theta1 = 1 - theta;
+    // y(t_k + theta * h) = y_k + theta * (dy + theta1 * (b + theta * (dy - h * k_7 - b + theta1 * h * sum_i d_i k_i)))
+    // with dy = y_{k+1} - y_k and b = h * k_1 - dy
+    m_dense.noalias() = h * (m_k * dense_coefficients());
+    const auto dy     = m_ytp1 - m_yt;
+    const auto b      = h * m_k.col(0) - dy;
+    y                 = m_yt + theta * (dy + theta1 * (b + theta * (dy - h * m_k.col(6) - b + theta1 * m_dense)));
+}
+
+} // namespace mio
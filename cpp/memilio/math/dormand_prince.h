@@ -0,0 +1,236 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_MATH_DORMAND_PRINCE_H
+#define MIO_MATH_DORMAND_PRINCE_H
+
+#include "memilio/math/integrator.h"
+#include "memilio/utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace mio
+{
+
+/**
+ * @brief Runge-Kutta method of Dormand and Prince (RK5(4)7M) with adaptive step size and dense output.
+ *
+ * The method uses 7 stages to compute a 5th order approximation, the error is estimated with an embedded 4th order
+ * approximation. The Butcher tableau is
+ * 0    |
+ * 1/5  | 1/5
+ * 3/10 | 3/40        9/40
+ * 4/5  | 44/45       -56/15      32/9
+ * 8/9  | 19372/6561  -25360/2187 64448/6561  -212/729
+ * 1    | 9017/3168   -355/33     46732/5247  49/176   -5103/18656
+ * 1    | 35/384      0           500/1113    125/192  -2187/6784   11/84
+ * -------------------------------------------------------------------------------
+ *      | 35/384      0           500/1113    125/192  -2187/6784   11/84    0
+ *      | 5179/57600  0           7571/16695  393/640  -92097/339200 187/2100 1/40
+ *
+ * The stages of the last step are kept to interpolate the solution inside of the step with the continuous extension
+ * of 4th order by Hairer, Norsett and Wanner (Solving Ordinary Differential Equations I, 1993, section II.6).
+ * The interpolation costs no additional evaluations of the right hand side. With this integrator, the OdeIntegrator
+ * does not shorten the last step before the end of the integration interval, it steps past it and interpolates.
+ * The step size stays as large as the tolerances allow, e.g., between the frequent exchanges of a graph simulation.
+ */
+class DormandPrinceIntegratorCore : public IntegratorCore
+{
+public:
+    /**
+     * @brief Set up the integrator.
+     * @param abs_tol absolute tolerance
+     * @param rel_tol relative tolerance
+     * @param dt_min lower bound for time step dt
+     * @param dt_max upper bound for time step dt
+     */
+    DormandPrinceIntegratorCore(const double abs_tol = 1e-10, const double rel_tol = 1e-5,
+                                const double dt_min = std::numeric_limits<double>::min(),
+                                const double dt_max = std::numeric_limits<double>::max())
+        : m_abs_tol(abs_tol)
+        , m_rel_tol(rel_tol)
+        , m_dt_min(dt_min)
+        , m_dt_max(dt_max)
+    {
+    }
+
+    /// @param tol the required absolute tolerance for the comparison with the embedded approximation
+    void set_abs_tolerance(double tol)
+    {
+        m_abs_tol = tol;
+    }
+
+    /// @param tol the required relative tolerance for the comparison with the embedded approximation
+    void set_rel_tolerance(double tol)
+    {
+        m_rel_tol = tol;
+    }
+
+    /// @param dt_min sets the minimum step size
+    void set_dt_min(double dt_min)
+    {
+        m_dt_min = dt_min;
+    }
+
+    /// @param dt_max sets the maximum step size
+    void set_dt_max(double dt_max)
+    {
+        m_dt_max = dt_max;
+    }
+
+    /**
+     * @brief Make a single integration step of a system of ODEs and adapt the step size.
+     * @param[in] yt value of y at t, y(t)
+     * @param[in,out] t current time
+     * @param[in,out] dt current time step size h=dt
+     * @param[out] ytp1 approximated value y(t+1)
+     */
+    bool step(const DerivFunction& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t, double& dt,
+              Eigen::Ref<Eigen::VectorXd> ytp1) const override;
+
+    /**
+     * @brief The solution can be interpolated inside of the last step.
+     */
+    bool has_dense_output() const override
+    {
+        return true;
+    }
+
+    /**
+     * @brief Interpolate the solution inside of the last successful step.
+     * @param[in] t A time inside of the last step [t_{k}, t_{k+1}].
+     * @param[out] y The approximated value of y(t).
+     */
+    void interpolate(double t, Eigen::Ref<Eigen::VectorXd> y) const override;
+
+    /**
+     * @brief Make a single integration step of a system of ODEs and adapt the step size, for any type of right hand
+     * side f.
+     * @see step(const DerivFunction&, Eigen::Ref<Eigen::VectorXd const>, double&, double&, Eigen::Ref<Eigen::VectorXd>)
+     */
+    template <class F>
+    bool step_static(const F& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t, double& dt,
+                     Eigen::Ref<Eigen::VectorXd> ytp1) const
+    {
+        // Butcher tableau, row i contains c_{i+1} and a_{i+1, j}
+        static const double c[]    = {0., 1. / 5, 3. / 10, 4. / 5, 8. / 9, 1., 1.};
+        static const double a[][6] = {{0, 0, 0, 0, 0, 0},
+                                      {1. / 5, 0, 0, 0, 0, 0},
+                                      {3. / 40, 9. / 40, 0, 0, 0, 0},
+                                      {44. / 45, -56. / 15, 32. / 9, 0, 0, 0},
+                                      {19372. / 6561, -25360. / 2187, 64448. / 6561, -212. / 729, 0, 0},
+                                      {9017. / 3168, -355. / 33, 46732. / 5247, 49. / 176, -5103. / 18656, 0},
+                                      {35. / 384, 0, 500. / 1113, 125. / 192, -2187. / 6784, 11. / 84}};
+
+        assert(0 <= m_dt_min);
+        assert(m_dt_min <= m_dt_max);
+
+        if (dt < m_dt_min || dt > m_dt_max) {
+            mio::log_warning("IntegratorCore: Restricting given step size dt = {} to [{}, {}].", dt, m_dt_min,
+                             m_dt_max);
+        }
+
+        dt = std::min(dt, m_dt_max);
+
+        bool converged     = false; // carry for convergence criterion
+        bool dt_is_invalid = false;
+
+        if (m_yt.size() != yt.size()) {
+            m_yt.resize(yt.size());
+            m_ytp1.resize(yt.size());
+            m_dense.resize(yt.size());
+            m_k.resize(yt.size(), 7);
+        }
+
+        m_yt = yt;
+
+        while (!converged && !dt_is_invalid) {
+            if (dt < m_dt_min) {
+                dt_is_invalid = true;
+                dt            = m_dt_min;
+            }
+            f(m_yt, t, m_k.col(0));
+            for (Eigen::Index i = 1; i < 7; ++i) {
+                // use ytp1 as temporary storage for the argument of stage i
+                ytp1 = m_yt;
+                for (Eigen::Index j = 0; j < i; ++j) {
+                    if (a[i][j] != 0) {
+                        ytp1 += (dt * a[i][j]) * m_k.col(j);
+                    }
+                }
+                f(ytp1, t + c[i] * dt, m_k.col(i));
+            }
+            // ytp1 now contains the argument of the last stage, which is the 5th order approximation (FSAL)
+
+            // truncation error estimate: difference of the approximations of 5th and 4th order
+            m_dense.noalias() = m_k * error_coefficients(); // use m_dense as temporary storage
+            m_error_estimate  = dt * m_dense.array().abs();
+            // calculate mixed tolerance
+            m_eps = m_abs_tol + ytp1.array().abs() * m_rel_tol;
+
+            converged = (m_error_estimate <= m_eps).all(); // convergence criterion
+
+            if (converged || dt_is_invalid) {
+                // keep the step for interpolation
+                m_ytp1    = ytp1;
+                m_t_last  = t;
+                m_dt_last = dt;
+                t += dt;
+            }
+
+            // compute new value for dt, the error estimate is of 4th order
+            // safety factor for more conservative step increases,
+            // and to avoid dt_new -> dt for step decreases when |error_estimate - eps| -> 0
+            double dt_new = 0.9 * dt * std::pow((m_eps / m_error_estimate).minCoeff(), 1. / 5);
+            // check if updated dt stays within desired bounds and update dt for next step
+            dt = std::min(dt_new, m_dt_max);
+        }
+        dt = std::max(dt, m_dt_min);
+        // return 'converged' in favor of '!dt_is_invalid', as these values only differ if step sizing failed,
+        // but the step with size dt_min was accepted.
+        return converged;
+    }
+
+private:
+    /**
+     * @brief Differences of the weights of the approximations of 5th and 4th order.
+     */
+    static const Eigen::Matrix<double, 7, 1>& error_coefficients();
+
+    /**
+     * @brief Weights of the stages in the 4th order coefficient of the continuous extension.
+     */
+    static const Eigen::Matrix<double, 7, 1>& dense_coefficients();
+
+    double m_abs_tol, m_rel_tol;
+    double m_dt_min, m_dt_max;
+    mutable Eigen::Matrix<double, Eigen::Dynamic, 7> m_k; ///< Stages of the last step.
+    mutable Eigen::VectorXd m_yt, m_ytp1; ///< Values at the start and the end of the last step.
+    mutable Eigen::VectorXd m_dense; ///< Temporary storage for interpolation.
+    mutable double m_t_last  = 0.; ///< Start of the last step.
+    mutable double m_dt_last = 0.; ///< Size of the last step.
+    mutable Eigen::ArrayXd m_eps, m_error_estimate; ///< Tolerance and estimate used for time step adaption.
+};
+
+} // namespace mio
+
+#endif // MIO_MATH_DORMAND_PRINCE_H
@@ -37,4 +37,15 @@ GCC_CLANG_DIAGNOSTIC(pop)
 
 MSVC_WARNING_POP()
 
+namespace mio
+{
+
+/**
+ * @brief Dynamically sized column vector with entries of type FP, e.g. Vector<double> is Eigen::VectorXd.
+ */
+template <class FP>
+using Vector = Eigen::Matrix<FP, Eigen::Dynamic, 1>;
+
+} // namespace mio
+
 #endif //EPI_UTILS_EIGEN_H
@@ -0,0 +1,39 @@
+/* 
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_MATH_EIGEN_SPARSE_H
+#define MIO_MATH_EIGEN_SPARSE_H
+
+#include "memilio/math/eigen.h"
+
+/* this file wraps includes from eigen3 library to disable warnings. */
+
+MSVC_WARNING_DISABLE_PUSH(4996)
+
+GCC_CLANG_DIAGNOSTIC(push)
+GCC_CLANG_DIAGNOSTIC(ignored "-Wint-in-bool-context")
+GCC_CLANG_DIAGNOSTIC(ignored "-Wshadow")
+
+#include <Eigen/SparseCore>
+
+GCC_CLANG_DIAGNOSTIC(pop)
+
+MSVC_WARNING_POP()
+
+#endif //MIO_MATH_EIGEN_SPARSE_H
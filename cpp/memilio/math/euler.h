@@ -29,8 +29,10 @@ namespace mio
 
 /**
  * @brief Simple explicit euler integration y(t+1) = y(t) + h*f(t,y) for ODE y'(t) = f(t,y)
+ * @tparam FP Floating point type of the entries of the state y.
  */
-class EulerIntegratorCore : public IntegratorCore
+template <class FP>
+class BasicEulerIntegratorCore : public BasicIntegratorCore<FP>
 {
 public:
     /**
@@ -41,10 +43,33 @@ public:
      * @param[in,out] dt current time step h=dt
      * @param[out] ytp1 approximated value y(t+1)
      */
-    bool step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t, double& dt,
-              Eigen::Ref<Eigen::VectorXd> ytp1) const override;
+    bool step(const BasicDerivFunction<FP>& f, Eigen::Ref<const Vector<FP>> yt, double& t, double& dt,
+              Eigen::Ref<Vector<FP>> ytp1) const override
+    {
+        return step_static(f, yt, t, dt, ytp1);
+    }
+
+    /**
+     * @brief Fixed step width of the integration, for any type of right hand side f.
+     * @see step(const BasicDerivFunction<FP>&, Eigen::Ref<const Vector<FP>>, double&, double&, Eigen::Ref<Vector<FP>>)
+     */
+    template <class F>
+    bool step_static(const F& f, Eigen::Ref<const Vector<FP>> yt, double& t, double& dt,
+              Eigen::Ref<Vector<FP>> ytp1) const
+    {
+        // we are misusing the next step y as temporary space to store the derivative
+        f(yt, t, ytp1);
+        ytp1 = yt + FP(dt) * ytp1;
+        t += dt;
+        return true;
+    }
 };
 
+/**
+ * @brief Explicit euler integration for states of type Eigen::VectorXd.
+ */
+using EulerIntegratorCore = BasicEulerIntegratorCore<double>;
+
 } // namespace mio
 
 #endif // EULER_H
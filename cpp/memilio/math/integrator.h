@@ -20,24 +20,46 @@
 #ifndef INTEGRATOR_H
 #define INTEGRATOR_H
 
+#include "memilio/math/eigen.h"
+#include "memilio/math/integrator_output.h"
 #include "memilio/utils/time_series.h"
+#include "memilio/utils/logging.h"
 
+#include <cassert>
 #include <memory>
 #include <functional>
 
 namespace mio
 {
 
+/**
+ * Function template to be integrated, for states with entries of type FP.
+ * The time is always a double, see BasicIntegratorCore.
+ */
+template <class FP>
+using BasicDerivFunction =
+    std::function<void(Eigen::Ref<const Vector<FP>> y, double t, Eigen::Ref<Vector<FP>> dydt)>;
+
 /**
  * Function template to be integrated
  */
-using DerivFunction =
-    std::function<void(Eigen::Ref<const Eigen::VectorXd> y, double t, Eigen::Ref<Eigen::VectorXd> dydt)>;
+using DerivFunction = BasicDerivFunction<double>;
 
-class IntegratorCore
+/**
+ * @brief Base class of the integration schemes used by BasicOdeIntegrator.
+ * Implementations usually also provide a template `step_static(const F& f, ...)` with the same parameters as step for
+ * any type of right hand side F, which is used by StaticOdeIntegrator to avoid virtual calls and std::function.
+ * The entries of the state have type FP, e.g. float to halve the memory traffic of large systems. The time and the
+ * step size are always double, since the time is accumulated over many steps.
+ * @tparam FP Floating point type of the entries of the state.
+ */
+template <class FP>
+class BasicIntegratorCore
 {
 public:
-    virtual ~IntegratorCore(){};
+    using Scalar = FP;
+
+    virtual ~BasicIntegratorCore(){};
 
     /**
      * @brief Make a single integration step.
@@ -62,21 +84,121 @@ public:
      * @return Always true for nonadaptive methods.
      *     (If adaptive, returns whether the adaptive step sizing was successful.)
      */
-    virtual bool step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t, double& dt,
-                      Eigen::Ref<Eigen::VectorXd> ytp1) const = 0;
+    virtual bool step(const BasicDerivFunction<FP>& f, Eigen::Ref<const Vector<FP>> yt, double& t, double& dt,
+                      Eigen::Ref<Vector<FP>> ytp1) const = 0;
+
+    /**
+     * @brief Whether the integration scheme has dense output, i.e., can interpolate the solution inside of the last
+     * step, see interpolate.
+     * Integrators with dense output do not shorten the last step to reach the end of the integration interval exactly,
+     * they step past it and interpolate the solution at the end instead.
+     */
+    virtual bool has_dense_output() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Interpolate the solution inside of the last successful step.
+     * Only available if has_dense_output() is true.
+     * @param[in] t A time inside of the last step [t_{k}, t_{k+1}].
+     * @param[out] y The approximated value of y(t).
+     */
+    virtual void interpolate(double /*t*/, Eigen::Ref<Vector<FP>> /*y*/) const
+    {
+        assert(false && "Integration scheme has no dense output.");
+    }
 };
 
+/**
+ * @brief Base class of the integration schemes for states of type Eigen::VectorXd.
+ */
+using IntegratorCore = BasicIntegratorCore<double>;
+
+namespace details
+{
+/**
+ * @brief Integrate from the last time point of the results to tmax.
+ * Implementation of OdeIntegrator::advance and StaticOdeIntegrator::advance.
+ * @param[in] step Makes a single integration step, `bool step(yt, t, dt, ytp1)`, see IntegratorCore::step.
+ * @param[in] interpolate Interpolates inside of the last step, `void interpolate(t, y)`, see
+ * IntegratorCore::interpolate. Only used if has_dense_output is true.
+ * @param[in] has_dense_output Whether the last step can be interpolated. If true, the last step is not shortened to
+ * reach tmax, the value at tmax is interpolated instead.
+ * @param[in] tmax Time end point. Must be greater than results.get_last_time().
+ * @param[in, out] dt Initial integration step size. May be changed by the step.
+ * @param[in, out] results List of results. The integration steps are added as selected by the output.
+ * @param[in, out] output Selects the time points that are stored in the results.
+ * @return A reference to the last value in the results time series.
+ */
+template <class FP, class Step, class Interpolate>
+Eigen::Ref<Vector<FP>> integrate(Step&& step, Interpolate&& interpolate, bool has_dense_output, const double tmax,
+                                 double& dt, TimeSeries<FP>& results, IntegratorOutput<FP>& output)
+{
+    const double t0 = results.get_last_time();
+    assert(tmax > t0);
+    assert(dt > 0);
+
+    const size_t num_steps =
+        static_cast<size_t>(ceil((tmax - t0) / dt)); // estimated number of time steps (if equidistant)
+
+    output.begin(results, tmax, num_steps);
+
+    bool step_okay = true;
+
+    double dt_restore = 0; // used to restore dt if dt was decreased to reach tmax
+    double t          = t0;
+    while (std::abs((tmax - t) / (tmax - t0)) > 1e-10) {
+        //we don't make timesteps too small as the error estimator of an adaptive integrator
+        //may not be able to handle it. this is very conservative and maybe unnecessary,
+        //but also unlikely to happen. may need to be reevaluated
+
+        if (!has_dense_output && dt > tmax - t) {
+            dt_restore = dt;
+            dt         = tmax - t;
+        }
+        results.add_time_point();
+        const auto i = results.get_num_time_points() - 2;
+        step_okay &= step(results[i], t, dt, results[i + 1]);
+        if (has_dense_output && t > tmax) {
+            // stepped past tmax, the step size stays optimal for the tolerances
+            interpolate(tmax, results[i + 1]);
+            t = tmax;
+        }
+        results.get_last_time() = FP(t);
+        output.step(results);
+    }
+    // if dt was decreased to reach tmax in the last time iteration,
+    // we restore it as it is now probably smaller than required for tolerances
+    dt = std::max(dt, dt_restore);
+
+    if (!step_okay) {
+        log_warning("Adaptive step sizing failed. Forcing an integration step of size dt_min.");
+    }
+    else if (std::abs((tmax - t) / (tmax - t0)) > 1e-14) {
+        log_warning("Last time step too small. Could not reach tmax exactly.");
+    }
+    else {
+        log_info("Adaptive step sizing successful to tolerances.");
+    }
+
+    return results.get_last_value();
+}
+} // namespace details
+
 /**
  * Integrate initial value problems (IVP) of ordinary differential equations (ODE) of the form y' = f(y, t), y(t0) = y0.
+ * @tparam FP Floating point type of the entries of the state y.
  */
-class OdeIntegrator
+template <class FP>
+class BasicOdeIntegrator
 {
 public:
     /**
      * @brief create an integrator for a specific IVP
      * @param[in] core implements the solution method
      */
-    OdeIntegrator(std::shared_ptr<IntegratorCore> core)
+    BasicOdeIntegrator(std::shared_ptr<BasicIntegratorCore<FP>> core)
         : m_core(core)
     {
     }
@@ -90,16 +212,120 @@ public:
      * intitial time and value. A new entry is added for each integration step.
      * @return A reference to the last value in the results time series.
      */
-    Eigen::Ref<Eigen::VectorXd> advance(const DerivFunction& f, const double tmax, double& dt,
-                                        TimeSeries<double>& results);
+    Eigen::Ref<Vector<FP>> advance(const BasicDerivFunction<FP>& f, const double tmax, double& dt,
+                                   TimeSeries<FP>& results)
+    {
+        IntegratorOutput<FP> output;
+        return advance(f, tmax, dt, results, output);
+    }
+
+    /**
+     * @brief Advance the integrator and store the time points selected by an output.
+     * @param[in] f The rhs of the ODE.
+     * @param[in] tmax Time end point. Must be greater than results.get_last_time().
+     * @param[in, out] dt Initial integration step size. May be changed by the IntegratorCore.
+     * @param[in, out] results List of results. Must contain at least one time point. The last entry is used as
+     * intitial time and value.
+     * @param[in, out] output Selects the time points that are stored in the results, see IntegratorOutput.
+     * @return A reference to the last value in the results time series.
+     */
+    Eigen::Ref<Vector<FP>> advance(const BasicDerivFunction<FP>& f, const double tmax, double& dt,
+                                   TimeSeries<FP>& results, IntegratorOutput<FP>& output)
+    {
+        return details::integrate(
+            [this, &f](auto&& yt, auto& t, auto& step_dt, auto&& ytp1) {
+                return m_core->step(f, yt, t, step_dt, ytp1);
+            },
+            [this](auto t, auto&& y) {
+                m_core->interpolate(t, y);
+            },
+            m_core->has_dense_output(), tmax, dt, results, output);
+    }
+
+    void set_integrator(std::shared_ptr<BasicIntegratorCore<FP>> integrator)
+    {
+        m_core = integrator;
+    }
+
+private:
+    std::shared_ptr<BasicIntegratorCore<FP>> m_core;
+};
+
+/**
+ * Integrate IVPs with states of type Eigen::VectorXd.
+ */
+using OdeIntegrator = BasicOdeIntegrator<double>;
+
+/**
+ * Integrate IVPs like OdeIntegrator, but with an integration scheme and right hand side whose types are known at
+ * compile time. The step of the core and the right hand side are called directly, not by virtual calls and
+ * std::function, so they can be inlined. This matters for small models, where evaluating the right hand side is cheap.
+ * @tparam Core An IntegratorCore that provides `template <class F> bool step_static(const F& f, ...)`,
+ * e.g. ControlledStepperWrapper, RKIntegratorCore or EulerIntegratorCore.
+ */
+template <class Core>
+class StaticOdeIntegrator
+{
+    using FP = typename Core::Scalar;
+
+public:
+    /**
+     * @brief create an integrator for a specific IVP
+     * @param[in] core implements the solution method
+     */
+    StaticOdeIntegrator(std::shared_ptr<Core> core)
+        : m_core(core)
+    {
+    }
+
+    /**
+     * @brief Advance the integrator.
+     * @param[in] f The rhs of the ODE, callable as `f(y, t, dydt)`, see DerivFunction.
+     * @param[in] tmax Time end point. Must be greater than results.get_last_time().
+     * @param[in, out] dt Initial integration step size. May be changed by the IntegratorCore.
+     * @param[in, out] results List of results. Must contain at least one time point. The last entry is used as
+     * intitial time and value. A new entry is added for each integration step.
+     * @return A reference to the last value in the results time series.
+     */
+    template <class F>
+    Eigen::Ref<Vector<FP>> advance(const F& f, const double tmax, double& dt, TimeSeries<FP>& results)
+    {
+        IntegratorOutput<FP> output;
+        return advance(f, tmax, dt, results, output);
+    }
+
+    /**
+     * @brief Advance the integrator and store the time points selected by an output.
+     * @param[in] f The rhs of the ODE, callable as `f(y, t, dydt)`, see DerivFunction.
+     * @param[in] tmax Time end point. Must be greater than results.get_last_time().
+     * @param[in, out] dt Initial integration step size. May be changed by the IntegratorCore.
+     * @param[in, out] results List of results. Must contain at least one time point. The last entry is used as
+     * intitial time and value.
+     * @param[in, out] output Selects the time points that are stored in the results, see IntegratorOutput.
+     * @return A reference to the last value in the results time series.
+     */
+    template <class F>
+    Eigen::Ref<Vector<FP>> advance(const F& f, const double tmax, double& dt, TimeSeries<FP>& results,
+                                   IntegratorOutput<FP>& output)
+    {
+        auto& core = *m_core;
+        return details::integrate(
+            [&core, &f](auto&& yt, auto& t, auto& step_dt, auto&& ytp1) {
+                return core.step_static(f, yt, t, step_dt, ytp1);
+            },
+            [&core](auto t, auto&& y) {
+                core.interpolate(t, y);
+            },
+            core.has_dense_output(), tmax, dt, results, output);
+    }
 
-    void set_integrator(std::shared_ptr<IntegratorCore> integrator)
+    void set_integrator(std::shared_ptr<Core> integrator)
     {
         m_core = integrator;
     }
 
 private:
-    std::shared_ptr<IntegratorCore> m_core;
+    std::shared_ptr<Core> m_core;
 };
 
 } // namespace mio
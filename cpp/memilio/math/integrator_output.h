@@ -0,0 +1,209 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_MATH_INTEGRATOR_OUTPUT_H
+#define MIO_MATH_INTEGRATOR_OUTPUT_H
+
+#include "memilio/math/eigen.h"
+#include "memilio/utils/time_series.h"
+
+#include <cassert>
+#include <cmath>
+
+namespace mio
+{
+
+/**
+ * @brief Selects which time points of an integration are stored in the results.
+ */
+enum class OutputPolicy
+{
+    AllSteps, ///< Store the result of every integration step.
+    LastStep, ///< Only store the result at the end time of each integration, i.e., of each call to advance.
+    Grid, ///< Store the results linearly interpolated at equidistant time points and the current state.
+};
+
+/**
+ * @brief Stores the results of integration steps in a TimeSeries according to an OutputPolicy.
+ * The last time point of the results is always the current state of the integration, so the results can be used to
+ * continue the integration and changes to the last value, e.g. by migration, are used by the next integration.
+ * With OutputPolicy::Grid, the current state is replaced by the next step if it is not on the grid. The grid
+ * consists of the time points t0 + k * dt_grid for integer k, the values are interpolated linearly between
+ * the integration steps, like interpolate_simulation_result does.
+ * Time points that were in the results before the integration are not changed, except for a last time point that is
+ * not on the grid.
+ * @tparam FP Floating point type of the results.
+ */
+template <class FP>
+class IntegratorOutput
+{
+public:
+    /**
+     * @brief Create an output with a policy.
+     * @param[in] policy Which time points are stored.
+     * @param[in] t0_grid Time of one of the grid points, usually the start time of the simulation.
+     * @param[in] dt_grid Distance of the grid points, only used with OutputPolicy::Grid.
+     */
+    IntegratorOutput(OutputPolicy policy = OutputPolicy::AllSteps, double t0_grid = 0.0, double dt_grid = 1.0)
+        : m_policy(policy)
+        , m_t0_grid(t0_grid)
+        , m_dt_grid(dt_grid)
+    {
+        assert(dt_grid > 0);
+    }
+
+    /**
+     * @brief The policy of this output.
+     */
+    OutputPolicy get_policy() const
+    {
+        return m_policy;
+    }
+
+    /**
+     * @brief Distance of the grid points.
+     */
+    double get_dt_grid() const
+    {
+        return m_dt_grid;
+    }
+
+    /**
+     * @brief Prepare an integration that starts at the last time point of the results.
+     * @param[in, out] results Results of previous integrations.
+     * @param[in] tmax End time of the integration.
+     * @param[in] num_steps Estimated number of integration steps.
+     */
+    void begin(TimeSeries<FP>& results, double tmax, size_t num_steps)
+    {
+        const auto num_time_points = results.get_num_time_points();
+        m_first_step               = num_time_points;
+        switch (m_policy) {
+        case OutputPolicy::AllSteps:
+            results.reserve(num_time_points + Eigen::Index(num_steps));
+            break;
+        case OutputPolicy::LastStep:
+            results.reserve(num_time_points + 1);
+            break;
+        case OutputPolicy::Grid:
+            m_last_is_kept = num_time_points == 1 || is_on_grid(results.get_last_time());
+            results.reserve(num_time_points + 1 +
+                            Eigen::Index(std::ceil((tmax - double(results.get_last_time())) / m_dt_grid)));
+            break;
+        }
+    }
+
+    /**
+     * @brief Store an integration step.
+     * @param[in, out] results Results of the integration, the last two time points are the states before and after
+     * the step.
+     */
+    void step(TimeSeries<FP>& results)
+    {
+        switch (m_policy) {
+        case OutputPolicy::AllSteps:
+            break;
+        case OutputPolicy::LastStep:
+            step_last(results);
+            break;
+        case OutputPolicy::Grid:
+            step_grid(results);
+            break;
+        }
+    }
+
+private:
+    /**
+     * @brief Replace the result of the previous step of the same integration by the new step.
+     */
+    void step_last(TimeSeries<FP>& results)
+    {
+        const auto i = results.get_num_time_points() - 2;
+        if (i >= m_first_step) {
+            results.get_time(i) = results.get_last_time();
+            results[i]          = results.get_last_value();
+            results.remove_last_time_point();
+        }
+    }
+
+    /**
+     * @brief Interpolate the step at the grid points and replace the previous state if it is not on the grid.
+     */
+    void step_grid(TimeSeries<FP>& results)
+    {
+        const auto n      = results.get_num_time_points();
+        const auto t_old  = double(results.get_time(n - 2));
+        const auto t_new  = double(results.get_time(n - 1));
+        const auto tol    = 1e-10 * m_dt_grid;
+        auto k            = std::floor((t_old - m_t0_grid) / m_dt_grid + 1e-10) + 1;
+        const auto t_grid = m_t0_grid + k * m_dt_grid;
+
+        if (t_grid > t_new + tol) {
+            //no grid point in this step
+            if (!m_last_is_kept) {
+                results.get_time(n - 2) = results.get_time(n - 1);
+                results[n - 2]          = results[n - 1];
+                results.remove_last_time_point();
+            }
+            m_last_is_kept = false;
+            return;
+        }
+
+        m_y_old = results[n - 2];
+        m_y_new = results[n - 1];
+        results.remove_last_time_point();
+        if (!m_last_is_kept) {
+            results.remove_last_time_point();
+        }
+        m_last_is_kept = false;
+        for (auto t = m_t0_grid + k * m_dt_grid; t <= t_new + tol; k += 1, t = m_t0_grid + k * m_dt_grid) {
+            if (t >= t_new - tol) {
+                results.add_time_point(FP(t_new), m_y_new);
+                m_last_is_kept = true;
+            }
+            else {
+                results.add_time_point(FP(t), m_y_old + FP((t - t_old) / (t_new - t_old)) * (m_y_new - m_y_old));
+            }
+        }
+        if (!m_last_is_kept) {
+            results.add_time_point(FP(t_new), m_y_new);
+        }
+    }
+
+    /**
+     * @brief Check if a time is a grid point.
+     */
+    bool is_on_grid(double t) const
+    {
+        auto k = std::round((t - m_t0_grid) / m_dt_grid);
+        return std::abs(t - (m_t0_grid + k * m_dt_grid)) <= 1e-10 * m_dt_grid;
+    }
+
+    OutputPolicy m_policy; ///< Which time points are stored.
+    double m_t0_grid; ///< Time of one of the grid points.
+    double m_dt_grid; ///< Distance of the grid points.
+    Eigen::Index m_first_step = 0; ///< Index of the first step of the current integration in the results.
+    bool m_last_is_kept       = true; ///< If the last time point is on the grid and must not be replaced.
+    Vector<FP> m_y_old; ///< State before the current step.
+    Vector<FP> m_y_new; ///< State after the current step.
+};
+
+} // namespace mio
+
+#endif // MIO_MATH_INTEGRATOR_OUTPUT_H
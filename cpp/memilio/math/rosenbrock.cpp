@@ -1,7 +1,7 @@
-/* 
+/*
 * Copyright (C) 2020-2024 MEmilio
 *
-* Authors: Martin J. Kuehn, Daniel Abele
+* Authors: Daniel Abele
 *
 * Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
 *
@@ -17,19 +17,15 @@
 * See the License for the specific language governing permissions and
 * limitations under the License.
 */
-#include "memilio/math/euler.h"
+#include "memilio/math/rosenbrock.h"
 
 namespace mio
 {
 
-bool EulerIntegratorCore::step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t, double& dt,
-                               Eigen::Ref<Eigen::VectorXd> ytp1) const
+bool RosenbrockIntegratorCore::step(const DerivFunction& f, Eigen::Ref<const Eigen::VectorXd> yt, double& t,
+                                    double& dt, Eigen::Ref<Eigen::VectorXd> ytp1) const
 {
-    // we are misusing the next step y as temporary space to store the derivative
-    f(yt, t, ytp1);
-    ytp1 = yt + dt * ytp1;
-    t += dt;
-    return true;
+    return step_static(f, yt, t, dt, ytp1);
 }
 
 } // namespace mio
@@ -0,0 +1,265 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_MATH_ROSENBROCK_H
+#define MIO_MATH_ROSENBROCK_H
+
+#include "memilio/math/eigen.h"
+#include "memilio/math/integrator.h"
+#include "memilio/utils/logging.h"
+
+GCC_CLANG_DIAGNOSTIC(push)
+GCC_CLANG_DIAGNOSTIC(ignored "-Wshadow")
+#include <Eigen/LU>
+GCC_CLANG_DIAGNOSTIC(pop)
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace mio
+{
+
+/**
+ * Function that evaluates the jacobian df/dy of the right hand side f(y, t) of a system of ODEs.
+ */
+using JacobianFunction =
+    std::function<void(Eigen::Ref<const Eigen::VectorXd> y, double t, Eigen::Ref<Eigen::MatrixXd> jacobian)>;
+
+/**
+ * @brief Linearly implicit Rosenbrock method of order 2(3) with adaptive step size for stiff systems of ODEs.
+ *
+ * Implements the modified Rosenbrock triple of Shampine and Reichelt (The MATLAB ODE Suite, 1997) that is also used
+ * by ode23s. With d = 1/(2 + sqrt(2)), e = 6 + sqrt(2), W = I - h d J and T = h d df/dt a step is
+ *    k_1     = W^{-1} (f(t_n, y_n) + T)
+ *    k_2     = W^{-1} (f(t_n + h/2, y_n + h/2 k_1) - k_1) + k_1
+ *    y_{n+1} = y_n + h k_2
+ *    k_3     = W^{-1} (f(t_n + h, y_{n+1}) - e (k_2 - f(t_n + h/2, y_n + h/2 k_1)) - 2 (k_1 - f(t_n, y_n)) + T)
+ * with the error estimate h/6 (k_1 - 2 k_2 + k_3).
+ * The method is L-stable and stays accurate with an approximate jacobian J (W-method). It does not fall to tiny steps
+ * for stiff systems, e.g., with large rates or fast smoothed transitions, where explicit methods are limited by
+ * their stability region. Each step solves three linear systems with the same matrix W.
+ *
+ * By default, the jacobian and the time derivative are approximated by finite differences, which costs n + 1
+ * additional evaluations of f per step for a system of size n. An analytic jacobian can be set with set_jacobian.
+ */
+class RosenbrockIntegratorCore : public IntegratorCore
+{
+public:
+    /**
+     * @brief Set up the integrator.
+     * @param abs_tol absolute tolerance
+     * @param rel_tol relative tolerance
+     * @param dt_min lower bound for time step dt
+     * @param dt_max upper bound for time step dt
+     */
+    RosenbrockIntegratorCore(const double abs_tol = 1e-10, const double rel_tol = 1e-5,
+                             const double dt_min = std::numeric_limits<double>::min(),
+                             const double dt_max = std::numeric_limits<double>::max())
+        : m_abs_tol(abs_tol)
+        , m_rel_tol(rel_tol)
+        , m_dt_min(dt_min)
+        , m_dt_max(dt_max)
+    {
+    }
+
+    /// @param tol the required absolute tolerance for the comparison with the error estimate
+    void set_abs_tolerance(double tol)
+    {
+        m_abs_tol = tol;
+    }
+
+    /// @param tol the required relative tolerance for the comparison with the error estimate
+    void set_rel_tolerance(double tol)
+    {
+        m_rel_tol = tol;
+    }
+
+    /// @param dt_min sets the minimum step size
+    void set_dt_min(double dt_min)
+    {
+        m_dt_min = dt_min;
+    }
+
+    /// @param dt_max sets the maximum step size
+    void set_dt_max(double dt_max)
+    {
+        m_dt_max = dt_max;
+    }
+
+    /**
+     * @brief Set an analytic jacobian of the right hand side instead of finite differences.
+     * The jacobian must belong to the right hand side f that is passed to step.
+     * @param jacobian Function that evaluates df/dy, or an empty function to use finite differences.
+     */
+    void set_jacobian(JacobianFunction jacobian)
+    {
+        m_jacobian = std::move(jacobian);
+    }
+
+    /**
+     * @brief Make a single integration step of a system of ODEs and adapt the step size.
+     * @param[in] yt value of y at t, y(t)
+     * @param[in,out] t current time
+     * @param[in,out] dt current time step size h=dt
+     * @param[out] ytp1 approximated value y(t+1)
+     */
+    bool step(const DerivFunction& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t, double& dt,
+              Eigen::Ref<Eigen::VectorXd> ytp1) const override;
+
+    /**
+     * @brief Make a single integration step of a system of ODEs and adapt the step size, for any type of right hand
+     * side f.
+     * @see step(const DerivFunction&, Eigen::Ref<Eigen::VectorXd const>, double&, double&, Eigen::Ref<Eigen::VectorXd>)
+     */
+    template <class F>
+    bool step_static(const F& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t, double& dt,
+                     Eigen::Ref<Eigen::VectorXd> ytp1) const
+    {
+        const double d   = 1. / (2. + std::sqrt(2.));
+        const double e32 = 6. + std::sqrt(2.);
+
+        assert(0 <= m_dt_min);
+        assert(m_dt_min <= m_dt_max);
+
+        if (dt < m_dt_min || dt > m_dt_max) {
+            mio::log_warning("IntegratorCore: Restricting given step size dt = {} to [{}, {}].", dt, m_dt_min,
+                             m_dt_max);
+        }
+
+        dt = std::min(dt, m_dt_max);
+
+        bool converged     = false; // carry for convergence criterion
+        bool dt_is_invalid = false;
+
+        const auto n = yt.size();
+        if (m_yt_eval.size() != n) {
+            m_yt_eval.resize(n);
+            m_f0.resize(n);
+            m_f1.resize(n);
+            m_f2.resize(n);
+            m_dfdt.resize(n);
+            m_k1.resize(n);
+            m_k2.resize(n);
+            m_k3.resize(n);
+            m_jac.resize(n, n);
+            m_w.resize(n, n);
+        }
+
+        m_yt_eval = yt;
+
+        // the jacobian and the time derivative are computed once per step and reused if the step is repeated
+        f(m_yt_eval, t, m_f0);
+        compute_jacobian(f, t);
+
+        while (!converged && !dt_is_invalid) {
+            if (!(dt >= m_dt_min)) {
+                dt_is_invalid = true;
+                dt            = m_dt_min;
+            }
+
+            m_w = -(dt * d) * m_jac;
+            m_w.diagonal().array() += 1.0;
+            m_lu.compute(m_w);
+
+            // k_1, use ytp1 as temporary storage
+            ytp1 = m_f0 + (dt * d) * m_dfdt;
+            m_k1 = m_lu.solve(ytp1);
+
+            // k_2
+            ytp1 = m_yt_eval + (0.5 * dt) * m_k1;
+            f(ytp1, t + 0.5 * dt, m_f1);
+            ytp1 = m_f1 - m_k1;
+            m_k2 = m_lu.solve(ytp1);
+            m_k2 += m_k1;
+
+            // solution
+            ytp1 = m_yt_eval + dt * m_k2;
+
+            // k_3 for the error estimate
+            f(ytp1, t + dt, m_f2);
+            m_f2 += -e32 * (m_k2 - m_f1) - 2. * (m_k1 - m_f0) + (dt * d) * m_dfdt;
+            m_k3 = m_lu.solve(m_f2);
+
+            m_error_estimate = (dt / 6.) * (m_k1 - 2. * m_k2 + m_k3).array().abs();
+            // calculate mixed tolerance
+            m_eps = m_abs_tol + ytp1.array().abs() * m_rel_tol;
+
+            converged = (m_error_estimate <= m_eps).all(); // convergence criterion
+
+            if (converged || dt_is_invalid) {
+                t += dt;
+            }
+
+            // compute new value for dt, the error estimate is of 2nd order
+            // safety factor for more conservative step increases,
+            // and to avoid dt_new -> dt for step decreases when |error_estimate - eps| -> 0
+            double dt_new = 0.9 * dt * std::pow((m_eps / m_error_estimate).minCoeff(), 1. / 3);
+            // check if updated dt stays within desired bounds and update dt for next step
+            dt = std::min(dt_new, m_dt_max);
+        }
+        dt = std::max(dt, m_dt_min);
+        // return 'converged' in favor of '!dt_is_invalid', as these values only differ if step sizing failed,
+        // but the step with size dt_min was accepted.
+        return converged;
+    }
+
+private:
+    /**
+     * @brief Compute the jacobian and the time derivative of f at (m_yt_eval, t).
+     * Uses the analytic jacobian if set, finite differences otherwise. Requires m_f0 = f(m_yt_eval, t).
+     */
+    template <class F>
+    void compute_jacobian(const F& f, double t) const
+    {
+        const double sqrt_eps = std::sqrt(std::numeric_limits<double>::epsilon());
+        if (m_jacobian) {
+            m_jacobian(m_yt_eval, t, m_jac);
+        }
+        else {
+            // forward differences, use m_f1 and m_f2 as temporary storage
+            m_f1 = m_yt_eval;
+            for (Eigen::Index j = 0; j < m_yt_eval.size(); ++j) {
+                const double delta = sqrt_eps * std::max(std::abs(m_yt_eval[j]), 1.0);
+                m_f1[j]            = m_yt_eval[j] + delta;
+                f(m_f1, t, m_f2);
+                m_jac.col(j) = (m_f2 - m_f0) / (m_f1[j] - m_yt_eval[j]);
+                m_f1[j]      = m_yt_eval[j];
+            }
+        }
+        const double delta = sqrt_eps * std::max(std::abs(t), 1.0);
+        f(m_yt_eval, t + delta, m_dfdt);
+        m_dfdt = (m_dfdt - m_f0) / delta;
+    }
+
+    double m_abs_tol, m_rel_tol;
+    double m_dt_min, m_dt_max;
+    JacobianFunction m_jacobian; ///< Optional analytic jacobian.
+    mutable Eigen::VectorXd m_yt_eval, m_f0, m_f1, m_f2, m_dfdt; ///< Evaluations of the right hand side.
+    mutable Eigen::VectorXd m_k1, m_k2, m_k3; ///< Stages.
+    mutable Eigen::MatrixXd m_jac, m_w; ///< Jacobian and W = I - h d J.
+    mutable Eigen::PartialPivLU<Eigen::MatrixXd> m_lu; ///< Decomposition of W.
+    mutable Eigen::ArrayXd m_eps, m_error_estimate; ///< Tolerance and estimate used for time step adaption.
+};
+
+} // namespace mio
+
+#endif // MIO_MATH_ROSENBROCK_H
@@ -86,6 +86,19 @@ public:
     */
     bool step(const mio::DerivFunction& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t, double& dt,
               Eigen::Ref<Eigen::VectorXd> ytp1) const override
+    {
+        return step_static(f, yt, t, dt, ytp1);
+    }
+
+    /**
+     * @brief Make a single integration step on a system of ODEs and adapt the step size dt, for any type of right hand
+     * side f.
+     * @see step(const mio::DerivFunction&, Eigen::Ref<Eigen::VectorXd const>, double&, double&,
+     * Eigen::Ref<Eigen::VectorXd>)
+     */
+    template <class F>
+    bool step_static(const F& f, Eigen::Ref<Eigen::VectorXd const> yt, double& t, double& dt,
+              Eigen::Ref<Eigen::VectorXd> ytp1) const
     {
         using boost::numeric::odeint::fail;
         assert(0 <= m_dt_min);
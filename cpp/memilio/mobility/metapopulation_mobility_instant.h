@@ -22,6 +22,7 @@
 
 #include "memilio/mobility/graph_simulation.h"
 #include "memilio/utils/time_series.h"
+#include "memilio/utils/ring_time_series.h"
 #include "memilio/math/eigen.h"
 #include "memilio/math/eigen_util.h"
 #include "memilio/utils/metaprogramming.h"
@@ -34,13 +35,18 @@
 
 #include "boost/filesystem.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 namespace mio
 {
 
 /**
  * represents the simulation in one node of the graph.
+ * The migration uses the last value of the result of the simulation at the time of the exchange. With an integrator
+ * that has dense output, e.g. DormandPrinceIntegratorCore, this value is interpolated, so the step size of the
+ * simulation is not reduced to hit the times of the exchanges.
  */
 template <class Sim>
 class SimulationNode
@@ -294,9 +300,10 @@ public:
 
 private:
     MigrationParameters m_parameters;
-    TimeSeries<double> m_migrated;
-    TimeSeries<double> m_return_times;
+    RingTimeSeries<double> m_migrated; ///< Migrants that have not returned yet, oldest first.
+    RingTimeSeries<double> m_return_times; ///< Time of return of the migrants, oldest first.
     bool m_return_migrated;
+    Eigen::VectorXd m_coefficients; ///< Buffer for the coefficients evaluated at the time of the migration.
     double m_t_last_dynamic_npi_check               = -std::numeric_limits<double>::infinity();
     std::pair<double, SimulationTime> m_dynamic_npi = {-std::numeric_limits<double>::max(), SimulationTime(0)};
 };
@@ -441,9 +448,10 @@ void MigrationEdge::apply_migration(double t, double dt, SimulationNode<Sim>& no
     //returns
     for (Eigen::Index i = m_return_times.get_num_time_points() - 1; i >= 0; --i) {
         if (m_return_times.get_time(i) <= t) {
-            auto v0 = find_value_reverse(node_to.get_result(), m_migrated.get_time(i), 1e-10, 1e-10);
-            assert(v0 != node_to.get_result().rend() && "unexpected error.");
-            calculate_migration_returns(m_migrated[i], node_to.get_simulation(), *v0, m_migrated.get_time(i), dt);
+            auto idx_migration = node_to.get_result().find_time(m_migrated.get_time(i), 1e-10, 1e-10);
+            assert(idx_migration < node_to.get_result().get_num_time_points() && "unexpected error.");
+            calculate_migration_returns(m_migrated[i], node_to.get_simulation(), node_to.get_result()[idx_migration],
+                                        m_migrated.get_time(i), dt);
 
             //the lower-order return calculation may in rare cases produce negative compartments,
             //especially at the beginning of the simulation.
@@ -472,12 +480,14 @@ void MigrationEdge::apply_migration(double t, double dt, SimulationNode<Sim>& no
         }
     }
 
-    if (!m_return_migrated && (m_parameters.get_coefficients().get_matrix_at(t).array() > 0.0).any()) {
+    if (!m_return_migrated) {
+        m_parameters.get_coefficients().get_matrix_at(t, m_coefficients);
+    }
+    if (!m_return_migrated && (m_coefficients.array() > 0.0).any()) {
         //normal daily migration
-        m_migrated.add_time_point(
-            t, (node_from.get_last_state().array() * m_parameters.get_coefficients().get_matrix_at(t).array() *
-                get_migration_factors(node_from, t, node_from.get_last_state()).array())
-                   .matrix());
+        m_migrated.add_time_point(t, (node_from.get_last_state().array() * m_coefficients.array() *
+                                      get_migration_factors(node_from, t, node_from.get_last_state()).array())
+                                         .matrix());
         m_return_times.add_time_point(t + dt);
 
         test_commuters(node_from, m_migrated.get_last_value(), t);
@@ -535,6 +545,30 @@ make_migration_sim(double t0, double dt, Graph<SimulationNode<Sim>, MigrationEdg
 
 /** @} */
 
+/**
+ * share the cache of evaluated contact matrices between nodes with equal contact matrices.
+ * The contact matrix of nodes with equal contact matrices and dampings is then evaluated only once
+ * for all of these nodes, see DampingMatrixExpressionGroup::share_cache.
+ * Call after the graph is set up, changes of the contact matrices during the simulation,
+ * e.g. by dynamic NPIs, stop the sharing for the changed node.
+ * @param graph graph of SimulationNodes.
+ * @param get_contact_matrices functor that returns a reference to the ContactMatrixGroup of a model.
+ */
+template <class Sim, class Edge, class F>
+void share_contact_matrix_caches(Graph<SimulationNode<Sim>, Edge>& graph, F get_contact_matrices)
+{
+    std::vector<ContactMatrixGroup*> distinct;
+    for (auto& node : graph.nodes()) {
+        ContactMatrixGroup& contact_matrices = get_contact_matrices(node.property.get_simulation().get_model());
+        auto iter_shared = std::find_if(distinct.begin(), distinct.end(), [&](auto other) {
+            return contact_matrices.share_cache(*other);
+        });
+        if (iter_shared == distinct.end()) {
+            distinct.push_back(&contact_matrices);
+        }
+    }
+}
+
 } // namespace mio
 
 #endif //METAPOPULATION_MOBILITY_INSTANT_H
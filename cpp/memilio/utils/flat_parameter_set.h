@@ -0,0 +1,210 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_UTILS_FLAT_PARAMETER_SET_H
+#define MIO_UTILS_FLAT_PARAMETER_SET_H
+
+#include "memilio/math/eigen.h"
+#include "memilio/utils/custom_index_array.h"
+#include "memilio/utils/parameter_set.h"
+#include "memilio/utils/uncertain_value.h"
+
+#include <cassert>
+#include <type_traits>
+
+namespace mio
+{
+
+/**
+ * @brief Defines how a parameter is stored in the flat vector of a ParameterSet, see flatten().
+ * Floating point values and UncertainValue%s are stored as one entry, CustomIndexArray%s of those
+ * as one entry per element in the order of the internal array. Other types, e.g. integers, flags, or
+ * contact matrices, are not stored.
+ * Specialize this struct to store other parameter types. A specialization defines the static members
+ * `is_numeric`, `size(const T&)`, `write(const T&, double*)` and `read(T&, const double*)`.
+ * @tparam T Type of the parameter.
+ */
+template <class T, class = void>
+struct FlatParameter {
+    static constexpr bool is_numeric = false;
+    static Eigen::Index size(const T&)
+    {
+        return 0;
+    }
+    static void write(const T&, double*)
+    {
+    }
+    static void read(T&, const double*)
+    {
+    }
+};
+
+template <class T>
+struct FlatParameter<T, std::enable_if_t<std::is_floating_point<T>::value>> {
+    static constexpr bool is_numeric = true;
+    static Eigen::Index size(const T&)
+    {
+        return 1;
+    }
+    static void write(const T& value, double* data)
+    {
+        *data = double(value);
+    }
+    static void read(T& value, const double* data)
+    {
+        value = T(*data);
+    }
+};
+
+template <>
+struct FlatParameter<UncertainValue> {
+    static constexpr bool is_numeric = true;
+    static Eigen::Index size(const UncertainValue&)
+    {
+        return 1;
+    }
+    static void write(const UncertainValue& value, double* data)
+    {
+        *data = value.value();
+    }
+    static void read(UncertainValue& value, const double* data)
+    {
+        //only the value is replaced, the distribution is kept
+        value = *data;
+    }
+};
+
+template <class T, class... Categories>
+struct FlatParameter<CustomIndexArray<T, Categories...>, std::enable_if_t<FlatParameter<T>::is_numeric>> {
+    static constexpr bool is_numeric = true;
+    static Eigen::Index size(const CustomIndexArray<T, Categories...>& array)
+    {
+        Eigen::Index s = 0;
+        for (auto& element : array) {
+            s += FlatParameter<T>::size(element);
+        }
+        return s;
+    }
+    static void write(const CustomIndexArray<T, Categories...>& array, double* data)
+    {
+        for (auto& element : array) {
+            FlatParameter<T>::write(element, data);
+            data += FlatParameter<T>::size(element);
+        }
+    }
+    static void read(CustomIndexArray<T, Categories...>& array, const double* data)
+    {
+        for (auto& element : array) {
+            FlatParameter<T>::read(element, data);
+            data += FlatParameter<T>::size(element);
+        }
+    }
+};
+
+/**
+ * @brief Number of entries of the flat vector of a ParameterSet.
+ * @param params A ParameterSet.
+ */
+template <class... Tags>
+Eigen::Index get_flat_size(const ParameterSet<Tags...>& params)
+{
+    Eigen::Index s = 0;
+    foreach (params, [&s](auto& p, auto /*tag*/) {
+        s += FlatParameter<std::decay_t<decltype(p)>>::size(p);
+    });
+    return s;
+}
+
+/**
+ * @brief Offset of a parameter in the flat vector of a ParameterSet.
+ * The offsets only depend on the types of the parameters and the sizes of CustomIndexArray parameters, so they
+ * stay the same as long as the dimensions of the parameters don't change, e.g. for all copies of the parameters
+ * of a model in a parameter study.
+ * @tparam Tag The parameter.
+ * @param params A ParameterSet.
+ * @return Index of the first entry of the parameter in the flat vector.
+ */
+template <class Tag, class... Tags>
+Eigen::Index get_flat_offset(const ParameterSet<Tags...>& params)
+{
+    Eigen::Index offset = 0;
+    bool found          = false;
+    foreach (params, [&offset, &found](auto& p, auto tag) {
+        found = found || std::is_same<decltype(tag), Tag>::value;
+        if (!found) {
+            offset += FlatParameter<std::decay_t<decltype(p)>>::size(p);
+        }
+    });
+    assert(found && "Tag is not a parameter of the ParameterSet.");
+    return offset;
+}
+
+/**
+ * @brief Write the values of all numeric parameters into a contiguous vector.
+ * The parameters are stored in the order of the tags of the ParameterSet, see FlatParameter and get_flat_offset().
+ * Samplers and fitting algorithms can work on the vector and write the result back with unflatten().
+ * @param[in] params A ParameterSet.
+ * @param[out] flat Vector of size get_flat_size(params).
+ */
+template <class... Tags>
+void flatten(const ParameterSet<Tags...>& params, Eigen::Ref<Eigen::VectorXd> flat)
+{
+    assert(flat.size() == get_flat_size(params));
+    auto data = flat.data();
+    foreach (params, [&data](auto& p, auto /*tag*/) {
+        using Flat = FlatParameter<std::decay_t<decltype(p)>>;
+        Flat::write(p, data);
+        data += Flat::size(p);
+    });
+}
+
+/**
+ * @brief Write the values of all numeric parameters into a new contiguous vector.
+ * @param[in] params A ParameterSet.
+ * @return Vector of size get_flat_size(params).
+ */
+template <class... Tags>
+Eigen::VectorXd flatten(const ParameterSet<Tags...>& params)
+{
+    Eigen::VectorXd flat(get_flat_size(params));
+    flatten(params, flat);
+    return flat;
+}
+
+/**
+ * @brief Set the values of all numeric parameters from a contiguous vector, inverse of flatten().
+ * Parameters that are not stored in the vector and the distributions of UncertainValue%s are not changed.
+ * @param[in] flat Vector of size get_flat_size(params).
+ * @param[in, out] params A ParameterSet.
+ */
+template <class... Tags>
+void unflatten(Eigen::Ref<const Eigen::VectorXd> flat, ParameterSet<Tags...>& params)
+{
+    assert(flat.size() == get_flat_size(params));
+    auto data = flat.data();
+    foreach (params, [&data](auto& p, auto /*tag*/) {
+        using Flat = FlatParameter<std::decay_t<decltype(p)>>;
+        Flat::read(p, data);
+        data += Flat::size(p);
+    });
+}
+
+} // namespace mio
+
+#endif // MIO_UTILS_FLAT_PARAMETER_SET_H
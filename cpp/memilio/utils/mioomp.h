@@ -14,6 +14,38 @@
 */
 #define PRAGMA_OMP(x) _Pragma(QUOTE(omp x))
 
+namespace mio
+{
+
+/**
+* @brief Index of the calling thread in the current parallel region.
+* @return Thread index in [0, get_omp_max_threads()).
+*/
+inline int get_omp_thread_id()
+{
+    return omp_get_thread_num();
+}
+
+/**
+* @brief Upper bound for the number of threads in a parallel region.
+* @return Maximum number of threads.
+*/
+inline int get_omp_max_threads()
+{
+    return omp_get_max_threads();
+}
+
+/**
+* @brief Set the number of threads used by following parallel regions.
+* @param num_threads Number of threads.
+*/
+inline void set_omp_num_threads(int num_threads)
+{
+    omp_set_num_threads(num_threads);
+}
+
+} // namespace mio
+
 #else
 
 /**
@@ -24,6 +56,37 @@
 */
 #define PRAGMA_OMP(x)
 
+namespace mio
+{
+
+/**
+* @brief Index of the calling thread in the current parallel region.
+* Always 0 because OpenMP is disabled.
+*/
+inline int get_omp_thread_id()
+{
+    return 0;
+}
+
+/**
+* @brief Upper bound for the number of threads in a parallel region.
+* Always 1 because OpenMP is disabled.
+*/
+inline int get_omp_max_threads()
+{
+    return 1;
+}
+
+/**
+* @brief Set the number of threads used by following parallel regions.
+* Does nothing because OpenMP is disabled.
+*/
+inline void set_omp_num_threads(int /*num_threads*/)
+{
+}
+
+} // namespace mio
+
 #endif
 
 #endif
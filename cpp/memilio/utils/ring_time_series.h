@@ -0,0 +1,295 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_UTILS_RING_TIME_SERIES_H
+#define MIO_UTILS_RING_TIME_SERIES_H
+
+#include "memilio/math/eigen.h"
+#include "memilio/utils/time_series.h"
+
+#include <cassert>
+
+namespace mio
+{
+
+/**
+ * @brief Stores vectors of values at time points in a circular buffer.
+ * Like TimeSeries, but time points can be added and removed at both ends in constant time, so it can be used as a
+ * queue of time points, e.g. for the migrants of a MigrationEdge that return later, or to keep only the most recent
+ * time points of a long simulation.
+ * The capacity grows like in TimeSeries if a time point is added to a full buffer. To bound the memory, remove the
+ * first time point before adding a new one once the required number of time points is reached.
+ * The time points are not stored contiguously, so there is no matrix() or data() access.
+ * @tparam FP any floating point like type accepted by Eigen
+ */
+template <class FP>
+class RingTimeSeries
+{
+public:
+    /** type that stores the data */
+    using Matrix = Eigen::Matrix<FP, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>;
+    /** base type of expressions of vector values at a time point */
+    using Vector = Eigen::Matrix<FP, Eigen::Dynamic, 1>;
+
+    /**
+     * initialize empty RingTimeSeries.
+     * @param num_elements size of vector at each time point
+     * @param capacity number of time points that can be stored without allocation
+     */
+    RingTimeSeries(Eigen::Index num_elements, Eigen::Index capacity = 0)
+        : m_data(num_elements + 1, capacity)
+        , m_first(0)
+        , m_num_time_points(0)
+    {
+        assert(num_elements >= 0 && capacity >= 0);
+    }
+
+    /**
+     * number of time points in the series
+     */
+    Eigen::Index get_num_time_points() const
+    {
+        return m_num_time_points;
+    }
+
+    /**
+     * number of elements of vector at each time point
+     */
+    Eigen::Index get_num_elements() const
+    {
+        return m_data.rows() - 1;
+    }
+
+    /**
+     * current capacity
+     */
+    Eigen::Index get_capacity() const
+    {
+        return m_data.cols();
+    }
+
+    /**
+     * reserve capacity for n time points
+     */
+    void reserve(Eigen::Index n)
+    {
+        assert(n >= 0);
+        if (n > get_capacity()) {
+            //move the time points to the beginning of the new storage
+            Matrix data(m_data.rows(), details::next_pow2(n));
+            for (Eigen::Index i = 0; i < m_num_time_points; ++i) {
+                data.col(i) = m_data.col(get_column(i));
+            }
+            m_data  = std::move(data);
+            m_first = 0;
+        }
+    }
+
+    /**
+     * add one time point after the last time point.
+     * initialize time.
+     */
+    Eigen::Ref<Vector> add_time_point(FP t)
+    {
+        reserve(m_num_time_points + 1);
+        ++m_num_time_points;
+        get_last_time() = t;
+        return get_last_value();
+    }
+
+    /**
+     * add one time point after the last time point.
+     * Initialize time and value.
+     * Expr can be any vector expression assignable to RingTimeSeries::Vector.
+     */
+    template <class Expr>
+    Eigen::Ref<Vector> add_time_point(FP t, Expr&& expr)
+    {
+        auto value = add_time_point(t);
+        value      = expr;
+        return value;
+    }
+
+    /**
+     * add one time point before the first time point.
+     * initialize time.
+     */
+    Eigen::Ref<Vector> add_first_time_point(FP t)
+    {
+        reserve(m_num_time_points + 1);
+        m_first = m_first == 0 ? get_capacity() - 1 : m_first - 1;
+        ++m_num_time_points;
+        get_time(0) = t;
+        return get_value(0);
+    }
+
+    /**
+     * add one time point before the first time point.
+     * Initialize time and value.
+     * Expr can be any vector expression assignable to RingTimeSeries::Vector.
+     */
+    template <class Expr>
+    Eigen::Ref<Vector> add_first_time_point(FP t, Expr&& expr)
+    {
+        auto value = add_first_time_point(t);
+        value      = expr;
+        return value;
+    }
+
+    /**
+     * remove the first time point in constant time.
+     */
+    void remove_first_time_point()
+    {
+        assert(m_num_time_points > 0);
+        m_first = get_column(1);
+        --m_num_time_points;
+    }
+
+    /**
+     * remove the last time point in constant time.
+     */
+    void remove_last_time_point()
+    {
+        assert(m_num_time_points > 0);
+        --m_num_time_points;
+    }
+
+    /**
+     * remove time point.
+     * The time points between i and the nearer end of the series are moved.
+     * @param i index to remove
+     */
+    void remove_time_point(Eigen::Index i)
+    {
+        assert(i >= 0 && i < m_num_time_points);
+        if (i < m_num_time_points / 2) {
+            for (auto j = i; j > 0; --j) {
+                m_data.col(get_column(j)) = m_data.col(get_column(j - 1));
+            }
+            remove_first_time_point();
+        }
+        else {
+            for (auto j = i; j < m_num_time_points - 1; ++j) {
+                m_data.col(get_column(j)) = m_data.col(get_column(j + 1));
+            }
+            remove_last_time_point();
+        }
+    }
+
+    /**
+     * remove all time points, the capacity is kept.
+     */
+    void clear()
+    {
+        m_first           = 0;
+        m_num_time_points = 0;
+    }
+
+    /**
+     * time of time point at index i
+     */
+    FP& get_time(Eigen::Index i)
+    {
+        assert(i >= 0 && i < m_num_time_points);
+        return m_data(0, get_column(i));
+    }
+    const FP& get_time(Eigen::Index i) const
+    {
+        assert(i >= 0 && i < m_num_time_points);
+        return m_data(0, get_column(i));
+    }
+
+    /**
+     * time of time point at index num_time_points - 1
+     */
+    FP& get_last_time()
+    {
+        return get_time(m_num_time_points - 1);
+    }
+    const FP& get_last_time() const
+    {
+        return get_time(m_num_time_points - 1);
+    }
+
+    /**
+     * reference to value vector at time point i
+     */
+    Eigen::Ref<const Vector> get_value(Eigen::Index i) const
+    {
+        assert(i >= 0 && i < m_num_time_points);
+        return m_data.col(get_column(i)).segment(1, get_num_elements());
+    }
+    Eigen::Ref<Vector> get_value(Eigen::Index i)
+    {
+        assert(i >= 0 && i < m_num_time_points);
+        return m_data.col(get_column(i)).segment(1, get_num_elements());
+    }
+    Eigen::Ref<const Vector> operator[](Eigen::Index i) const
+    {
+        return get_value(i);
+    }
+    Eigen::Ref<Vector> operator[](Eigen::Index i)
+    {
+        return get_value(i);
+    }
+
+    /**
+     * reference to value vector at time point (num_timepoints - 1)
+     */
+    Eigen::Ref<const Vector> get_last_value() const
+    {
+        return get_value(m_num_time_points - 1);
+    }
+    Eigen::Ref<Vector> get_last_value()
+    {
+        return get_value(m_num_time_points - 1);
+    }
+
+    /**
+     * copy the time points to a TimeSeries.
+     */
+    TimeSeries<FP> to_time_series() const
+    {
+        TimeSeries<FP> ts(get_num_elements());
+        ts.reserve(m_num_time_points);
+        for (Eigen::Index i = 0; i < m_num_time_points; ++i) {
+            ts.add_time_point(get_time(i), get_value(i));
+        }
+        return ts;
+    }
+
+private:
+    /**
+     * column of the storage that contains the time point at index i.
+     */
+    Eigen::Index get_column(Eigen::Index i) const
+    {
+        auto col = m_first + i;
+        return col >= get_capacity() ? col - get_capacity() : col;
+    }
+
+    Matrix m_data; ///< One time point per column, the first time point is in column m_first.
+    Eigen::Index m_first; ///< Column of the first time point.
+    Eigen::Index m_num_time_points; ///< Number of stored time points.
+};
+
+} // namespace mio
+
+#endif // MIO_UTILS_RING_TIME_SERIES_H
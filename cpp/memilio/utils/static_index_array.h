@@ -0,0 +1,228 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_UTILS_STATIC_INDEX_ARRAY_H
+#define MIO_UTILS_STATIC_INDEX_ARRAY_H
+
+#include "memilio/math/eigen.h"
+#include "memilio/utils/index.h"
+
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+namespace mio
+{
+
+/**
+ * @brief Number of values of a category that is known at compile time.
+ * Defined for enum categories as the value of the enumerator `Count`.
+ * Specialize for other categories with a fixed number of values.
+ * @tparam Tag A category.
+ */
+template <class Tag, class = void>
+struct StaticExtent;
+
+template <class Tag>
+struct StaticExtent<Tag, std::enable_if_t<std::is_enum<Tag>::value>>
+    : std::integral_constant<size_t, static_cast<size_t>(Tag::Count)> {
+};
+
+/**
+ * @brief Array with custom indices like CustomIndexArray whose dimensions are known at compile time.
+ *
+ * The size of each dimension is the StaticExtent of its category, e.g. `VirusVariant::Count`. The flat index is
+ * computed with constant strides and the elements are stored inline without heap allocation, so small arrays
+ * are cheap to create, copy, and index.
+ * Supports the element access, iteration and the flat array of CustomIndexArray, but no resizing and no slices.
+ *
+ * Example:
+ *
+ * StaticIndexArray<double, VirusVariant> exposure({VirusVariant::Count}, 0.);
+ * exposure[{VirusVariant::Wildtype}] += 1.0;
+ *
+ * @tparam Typ the type stored in the array
+ * @tparam Tags Categories with a StaticExtent.
+ */
+template <class Typ, class... Tags>
+class StaticIndexArray
+{
+public:
+    using Type  = Typ;
+    using Index = ::mio::Index<Tags...>;
+
+    static constexpr size_t Numel = (StaticExtent<Tags>::value * ...);
+    static_assert(Numel > 0, "StaticIndexArray must not be empty.");
+
+    using InternalArrayType = Eigen::Array<Type, Eigen::Index(Numel), 1, Eigen::ColMajor | Eigen::DontAlign>;
+
+    /**
+     * @brief Initializes all elements with a default constructed value.
+     */
+    StaticIndexArray()
+        : m_y(InternalArrayType::Constant(Type{}))
+    {
+    }
+
+    /**
+     * @brief Initializes all elements with the same value.
+     * Has the same signature as the constructor of CustomIndexArray, so both can be constructed the same way.
+     * @param dims The dimensions of the array, must be equal to size().
+     * @param args The constructor arguments of Type.
+     */
+    template <class... Ts, typename std::enable_if_t<std::is_constructible<Type, Ts...>::value>* = nullptr>
+    StaticIndexArray(Index const& dims, Ts&&... args)
+        : m_y(InternalArrayType::Constant(Type{std::forward<Ts>(args)...}))
+    {
+        assert(dims == size() && "Dimensions must be equal to the static extents.");
+        unused(dims);
+    }
+
+    /**
+     * @brief Number of elements, the product of the dimension sizes.
+     */
+    static constexpr size_t numel()
+    {
+        return Numel;
+    }
+
+    /**
+     * @brief Size along the dimension provided as template parameter.
+     * @tparam Tag Tag of the queried dimension/category.
+     */
+    template <typename Tag>
+    static mio::Index<Tag> size()
+    {
+        return mio::Index<Tag>(StaticExtent<Tag>::value);
+    }
+
+    /**
+     * @brief Size of the array along all dimensions.
+     */
+    static Index size()
+    {
+        return Index(mio::Index<Tags>(StaticExtent<Tags>::value)...);
+    }
+
+    /**
+     * @brief Reference to the internally stored flat array.
+     * @{
+     */
+    InternalArrayType const& array() const
+    {
+        return m_y;
+    }
+    InternalArrayType& array()
+    {
+        return m_y;
+    }
+    /** @} */
+
+    /**
+     * @brief Element of the array at a MultiIndex.
+     * @{
+     */
+    Type& operator[](Index const& index)
+    {
+        return m_y[get_flat_index(index)];
+    }
+    Type const& operator[](Index const& index) const
+    {
+        return m_y[get_flat_index(index)];
+    }
+    /** @} */
+
+    /**
+     * Assign the same value to each element of the array.
+     * @param scalar scalar value.
+     */
+    StaticIndexArray& operator=(const Type& scalar)
+    {
+        m_y = scalar;
+        return *this;
+    }
+
+    /**
+     * Equality comparison.
+     * @{
+     */
+    bool operator==(const StaticIndexArray& other) const
+    {
+        return (m_y == other.m_y).all();
+    }
+    bool operator!=(const StaticIndexArray& other) const
+    {
+        return !(*this == other);
+    }
+    /**@}*/
+
+    /**
+     * @brief Flat index into the stored array in row major order, like flatten_index for CustomIndexArray.
+     * All strides are constants, so the index arithmetic can be evaluated at compile time for constant indices.
+     * @param index the custom indices for each category
+     */
+    static size_t get_flat_index(Index const& index)
+    {
+        return get_flat_index(index, std::make_index_sequence<sizeof...(Tags)>{});
+    }
+
+    using value_type     = Type;
+    using reference      = Type&;
+    using iterator       = Type*;
+    using const_iterator = Type const*;
+
+    /**
+     * @brief Iterators over the elements in the order of the flat array.
+     * @{
+     */
+    iterator begin()
+    {
+        return m_y.data();
+    }
+    const_iterator begin() const
+    {
+        return m_y.data();
+    }
+    iterator end()
+    {
+        return m_y.data() + Numel;
+    }
+    const_iterator end() const
+    {
+        return m_y.data() + Numel;
+    }
+    /** @} */
+
+private:
+    template <size_t... Is>
+    static size_t get_flat_index(Index const& index, std::index_sequence<Is...>)
+    {
+        size_t flat = 0;
+        ((assert((size_t)get<Is>(index) < StaticExtent<Tags>::value),
+          flat = flat * StaticExtent<Tags>::value + (size_t)get<Is>(index)),
+         ...);
+        return flat;
+    }
+
+    InternalArrayType m_y; ///< The elements.
+};
+
+} // namespace mio
+
+#endif // MIO_UTILS_STATIC_INDEX_ARRAY_H
@@ -27,6 +27,7 @@
 #include "memilio/utils/compiler_diagnostics.h"
 #include "memilio/math/floating_point.h"
 
+#include <algorithm>
 #include <iterator>
 #include <vector>
 #include <map>
@@ -286,6 +287,66 @@ public:
         return get_value(m_num_time_points - 1);
     }
 
+    /**
+     * @brief Index of the first time point that is not before t.
+     * The times must be sorted in non-descending order, as they are in simulation results.
+     * Uses binary search.
+     * @param t a time
+     * @return index i with get_time(i - 1) < t <= get_time(i), or get_num_time_points() if all times are before t.
+     */
+    Eigen::Index lower_bound_time(FP t) const
+    {
+        auto times = get_const_times();
+        return std::lower_bound(times.begin(), times.end(), t) - times.begin();
+    }
+
+    /**
+     * @brief Index of the time point at time t.
+     * The times must be sorted in non-descending order, as they are in simulation results.
+     * Uses binary search. If more than one time point is equal to t within the tolerances, the last one is found.
+     * @param t a time
+     * @param abs_tol absolute floating point tolerance for equality of time values
+     * @param rel_tol relative floating point tolerance for equality of time values
+     * @return index i with get_time(i) == t, or get_num_time_points() if there is no time point at t.
+     */
+    Eigen::Index find_time(FP t, FP abs_tol = 0, FP rel_tol = 0) const
+    {
+        auto times = get_const_times();
+        auto i     = std::upper_bound(times.begin(), times.end(), t) - times.begin();
+        //the time point after t may be equal to t within the tolerances
+        if (i < m_num_time_points && floating_point_equal(get_time(i), t, abs_tol, rel_tol)) {
+            return i;
+        }
+        if (i > 0 && floating_point_equal(get_time(i - 1), t, abs_tol, rel_tol)) {
+            return i - 1;
+        }
+        return m_num_time_points;
+    }
+
+    /**
+     * @brief Linear interpolation of the values at time t.
+     * The times must be sorted in non-descending order, as they are in simulation results.
+     * Values before the first or after the last time point are set to the first or last value.
+     * @param[in] t a time
+     * @param[out] value the interpolated value at time t
+     */
+    void interpolate(FP t, Eigen::Ref<Vector> value) const
+    {
+        assert(m_num_time_points > 0);
+        auto i = lower_bound_time(t);
+        if (i == 0) {
+            value = get_value(0);
+        }
+        else if (i == m_num_time_points) {
+            value = get_last_value();
+        }
+        else {
+            auto t0 = get_time(i - 1);
+            auto t1 = get_time(i);
+            value   = get_value(i - 1) + ((t - t0) / (t1 - t0)) * (get_value(i) - get_value(i - 1));
+        }
+    }
+
     /**
      * reserve capacity for n time points
      */
@@ -338,6 +399,32 @@ public:
     }
     /** @} */
 
+    /**
+     * Matrix expression of the values without the times that contains one time point per row and one element per
+     * column. Transposed view of the storage, no copy.
+     * The values of one time point are contiguous, the trajectory of one element over time is a column with a
+     * stride of get_num_elements() + 1. Use trajectories() for contiguous trajectories.
+     * @{
+     */
+    auto values_by_time()
+    {
+        return get_valid_block().bottomRows(get_num_elements()).transpose();
+    }
+    auto values_by_time() const
+    {
+        return get_valid_block().bottomRows(get_num_elements()).transpose();
+    }
+    /** @} */
+
+    /**
+     * Copy of the values in column major storage with one time point per row and one element per column.
+     * The trajectory of each element over time is contiguous, e.g. for plotting or statistics over time.
+     */
+    Eigen::Matrix<FP, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor> trajectories() const
+    {
+        return values_by_time();
+    }
+
     /*********************
      * 
      * Iterator interface to iterate over values.
@@ -806,7 +893,8 @@ public:
 };
 
 /**
- * find the value in the time series at time t_search starting from the end.
+ * find the value in the time series at time t_search.
+ * The times must be sorted in non-descending order, see TimeSeries::find_time.
  * @param ts TimeSeries to seach
  * @param t_search a time point
  * @param abs_tol absolute floating point tolerance for equality of time values
@@ -816,11 +904,9 @@ public:
 template <class TS, class FP>
 decltype(std::declval<TS>().rend()) find_value_reverse(TS&& ts, FP t_search, FP abs_tol = 0, FP rel_tol = 0)
 {
-    auto iter_t = find_if(ts.get_reverse_times().begin(), ts.get_reverse_times().end(), [=](auto t) {
-        return floating_point_equal(t, t_search, abs_tol, rel_tol);
-    });
-    if (iter_t != ts.get_reverse_times().end()) {
-        return ts.rbegin() + (iter_t - ts.get_reverse_times().begin());
+    auto i = ts.find_time(t_search, abs_tol, rel_tol);
+    if (i < ts.get_num_time_points()) {
+        return ts.rbegin() + (ts.get_num_time_points() - 1 - i);
     }
     return ts.rend();
 }
@@ -29,6 +29,10 @@ void UncertainValue::set_distribution(const ParameterDistribution& dist)
 
 observer_ptr<ParameterDistribution> UncertainValue::get_distribution()
 {
+    //copy on write, the distribution must not be modified while other UncertainValues refer to it
+    if (m_dist && m_dist.use_count() > 1) {
+        m_dist.reset(m_dist->clone());
+    }
     return m_dist.get();
 }
 
@@ -40,7 +44,8 @@ observer_ptr<const ParameterDistribution> UncertainValue::get_distribution() con
 double UncertainValue::draw_sample()
 {
     if (m_dist) {
-        m_value = m_dist->get_sample();
+        //sampling changes the state of the distribution, e.g. the predefined samples
+        m_value = get_distribution()->get_sample();
     }
 
     return m_value;
@@ -39,6 +39,12 @@ namespace mio
  * The uncertainty is represented by a distribution object of kind
  * ParameterDistribution and the current scalar value can be 
  * replaced by drawing a new sample from the the distribution
+ *
+ * Copies of an UncertainValue share the distribution object until one of the copies modifies it
+ * (copy on write), so copying the parameters of a model for a graph node or a run of a parameter study
+ * does not allocate. The distribution is cloned when it is modified through get_distribution(),
+ * set_distribution() or draw_sample() while it is shared. A pointer returned by the non-const
+ * get_distribution() must not be used to modify the distribution after the UncertainValue has been copied.
  */
 class UncertainValue
 {
@@ -54,32 +60,6 @@ public:
     {
     }
 
-    UncertainValue(UncertainValue&& other) = default;
-
-    /**
-    * @brief Create an UncertainValue by cloning scalar value 
-    *        and distribution of another UncertainValue
-    */
-    UncertainValue(const UncertainValue& other)
-        : m_value(other.m_value)
-    {
-        if (other.m_dist) {
-            m_dist.reset(other.m_dist->clone());
-        }
-    }
-
-    /**
-    * @brief Set an UncertainValue from another UncertainValue
-    *        containing a scalar and a distribution
-    */
-    UncertainValue& operator=(const UncertainValue& other)
-    {
-        UncertainValue tmp(other);
-        m_value = tmp.m_value;
-        std::swap(m_dist, tmp.m_dist);
-        return *this;
-    }
-
     /**
      * @brief Conversion to scalar by returning the scalar contained in UncertainValue
      */
@@ -113,7 +93,7 @@ public:
      * @brief Sets the distribution of the value.
      *
      * The function uses copy semantics, i.e. it copies
-     * the distribution object.
+     * the distribution object. Copies of this UncertainValue keep the old distribution.
      */
     void set_distribution(const ParameterDistribution& dist);
 
@@ -125,9 +105,10 @@ public:
     observer_ptr<const ParameterDistribution> get_distribution() const;
 
     /**
-     * @brief Returns the parameter distribution.
+     * @brief Returns the parameter distribution for modification.
      *
      * If it is not set, a nullptr is returned.
+     * If the distribution is shared with copies of this UncertainValue, it is cloned first.
      */
     observer_ptr<ParameterDistribution> get_distribution();
 
@@ -207,7 +188,7 @@ public:
 
 private:
     ScalarType m_value;
-    std::unique_ptr<ParameterDistribution> m_dist;
+    std::shared_ptr<ParameterDistribution> m_dist; ///< Shared by copies, cloned before modification.
 };
 
 //gtest printer
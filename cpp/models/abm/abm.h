@@ -25,6 +25,9 @@
 #include "abm/parameters.h"
 #include "abm/simulation.h"
 #include "abm/world.h"
+#include "abm/multi_region_world.h"
+#include "abm/step_hooks.h"
+#include "abm/transmission_tree.h"
 #include "abm/person.h"
 #include "abm/location.h"
 #include "abm/location_type.h"
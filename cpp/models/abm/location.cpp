@@ -44,13 +44,14 @@ Location::Location(LocationId loc_id, size_t num_agegroups, uint32_t num_cells)
 
 Location Location::copy_location_without_persons(size_t num_agegroups)
 {
-    Location copy_loc  = Location(*this);
-    copy_loc.m_persons = std::vector<observer_ptr<Person>>();
-    copy_loc.m_cells   = std::vector<Cell>{num_agegroups};
+    Location copy_loc           = Location(*this);
+    copy_loc.m_persons          = std::vector<observer_ptr<Person>>();
+    copy_loc.m_cells_of_persons = std::vector<std::vector<uint32_t>>();
+    copy_loc.m_cells            = std::vector<Cell>(m_cells.size(), Cell(num_agegroups));
     for (uint32_t idx = 0; idx < m_cells.size(); idx++) {
         copy_loc.set_capacity(get_capacity(idx).persons, get_capacity(idx).volume, idx);
-        copy_loc.get_cached_exposure_rate_contacts(idx) = get_cached_exposure_rate_contacts(idx);
-        copy_loc.get_cached_exposure_rate_air(idx)      = get_cached_exposure_rate_air(idx);
+        copy_loc.m_cells[idx].m_cached_exposure_rate_contacts = m_cells[idx].m_cached_exposure_rate_contacts;
+        copy_loc.m_cells[idx].m_cached_exposure_rate_air      = m_cells[idx].m_cached_exposure_rate_air;
     }
     return copy_loc;
 }
@@ -77,32 +78,31 @@ ScalarType Location::transmission_air_per_day(uint32_t cell_index, VirusVariant
 void Location::interact(Person::RandomNumberGenerator& rng, Person& person, TimePoint t, TimeSpan dt,
                         const Parameters& global_params) const
 {
-    // TODO: we need to define what a cell is used for, as the loop may lead to incorrect results for multiple cells
     auto age_receiver          = person.get_age();
     ScalarType mask_protection = person.get_mask_protective_factor(global_params);
-    assert(person.get_cells().size() && "Person is in multiple cells. Interact logic is incorrect at the moment.");
-    for (auto cell_index :
-         person.get_cells()) { // TODO: the logic here is incorrect in case a person is in multiple cells
-        std::pair<VirusVariant, ScalarType> local_indiv_trans_prob[static_cast<uint32_t>(VirusVariant::Count)];
-        for (uint32_t v = 0; v != static_cast<uint32_t>(VirusVariant::Count); ++v) {
-            VirusVariant virus = static_cast<VirusVariant>(v);
-            ScalarType local_indiv_trans_prob_v =
-                (std::min(
-                     m_parameters.get<MaximumContacts>(),
-                     transmission_contacts_per_day(cell_index, virus, age_receiver, global_params.get_num_groups())) +
-                 transmission_air_per_day(cell_index, virus, global_params)) *
-                (1 - mask_protection) * dt.days() * (1 - person.get_protection_factor(t, virus, global_params));
-
-            local_indiv_trans_prob[v] = std::make_pair(virus, local_indiv_trans_prob_v);
-        }
-        VirusVariant virus =
-            random_transition(rng, VirusVariant::Count, dt,
-                              local_indiv_trans_prob); // use VirusVariant::Count for no virus submission
-        if (virus != VirusVariant::Count) {
-            person.add_new_infection(Infection(rng, virus, age_receiver, global_params, t + dt / 2,
-                                               mio::abm::InfectionState::Exposed, person.get_latest_protection(),
-                                               false)); // Starting time in first approximation
+    assert(person.get_cells().size() && "Person is not in any Cell of the Location.");
+    std::pair<VirusVariant, ScalarType> local_indiv_trans_prob[static_cast<uint32_t>(VirusVariant::Count)];
+    for (uint32_t v = 0; v != static_cast<uint32_t>(VirusVariant::Count); ++v) {
+        VirusVariant virus = static_cast<VirusVariant>(v);
+        // the exposure of all cells the person visits adds up, as the person is exposed to all of them
+        ScalarType exposure_rate = 0;
+        for (auto cell_index : person.get_cells()) {
+            auto contacts_per_day =
+                transmission_contacts_per_day(cell_index, virus, age_receiver, global_params.get_num_groups());
+            exposure_rate += std::min(m_parameters.get<MaximumContacts>(), contacts_per_day) +
+                             transmission_air_per_day(cell_index, virus, global_params);
         }
+        ScalarType local_indiv_trans_prob_v = exposure_rate * (1 - mask_protection) * dt.days() *
+                                              (1 - person.get_protection_factor(t, virus, global_params));
+
+        local_indiv_trans_prob[v] = std::make_pair(virus, local_indiv_trans_prob_v);
+    }
+    VirusVariant virus = random_transition(rng, VirusVariant::Count, dt,
+                                           local_indiv_trans_prob); // use VirusVariant::Count for no virus submission
+    if (virus != VirusVariant::Count) {
+        person.add_new_infection(Infection(rng, virus, age_receiver, global_params, t + dt / 2,
+                                           mio::abm::InfectionState::Exposed, person.get_latest_protection(),
+                                           false)); // Starting time in first approximation
     }
 }
 
@@ -111,40 +111,114 @@ void Location::cache_exposure_rates(TimePoint t, TimeSpan dt, size_t num_agegrou
     //cache for next step so it stays constant during the step while subpopulations change
     //otherwise we would have to cache all state changes during a step which uses more memory
     for (auto& cell : m_cells) {
-        cell.m_cached_exposure_rate_contacts = {{VirusVariant::Count, AgeGroup(num_agegroups)}, 0.};
-        cell.m_cached_exposure_rate_air      = {{VirusVariant::Count}, 0.};
-        for (auto&& p : cell.m_persons) {
-            if (p->is_infected(t)) {
-                auto& inf  = p->get_infection();
-                auto virus = inf.get_virus_variant();
-                auto age   = p->get_age();
-                /* average infectivity over the time step 
-                 *  to second order accuracy using midpoint rule
-                */
-                cell.m_cached_exposure_rate_contacts[{virus, age}] += inf.get_infectivity(t + dt / 2);
-                cell.m_cached_exposure_rate_air[{virus}] += inf.get_infectivity(t + dt / 2);
+        //resize only reallocates if the number of age groups changed
+        cell.m_cached_exposure_rate_contacts.resize({VirusVariant::Count, AgeGroup(num_agegroups)});
+        cell.m_cached_exposure_rate_contacts = 0.;
+        cell.m_cached_exposure_rate_air      = 0.;
+    }
+    //every person contributes to all cells it is in, so only the occupied cells are visited
+    for (size_t i = 0; i < m_persons.size(); ++i) {
+        auto&& p = m_persons[i];
+        if (p->is_infected(t)) {
+            auto& inf  = p->get_infection();
+            auto virus = inf.get_virus_variant();
+            auto age   = p->get_age();
+            /* average infectivity over the time step 
+             *  to second order accuracy using midpoint rule
+            */
+            auto infectivity = inf.get_infectivity(t + dt / 2);
+            for (auto cell_idx : m_cells_of_persons[i]) {
+                m_cells[cell_idx].m_cached_exposure_rate_contacts[{virus, age}] += infectivity;
+                m_cells[cell_idx].m_cached_exposure_rate_air[{virus}] += infectivity;
             }
         }
-        if (m_capacity_adapted_transmission_risk) {
+    }
+    if (m_capacity_adapted_transmission_risk) {
+        for (auto& cell : m_cells) {
             cell.m_cached_exposure_rate_air.array() *= cell.compute_space_per_person_relative();
         }
     }
 }
 
+observer_ptr<const Person> Location::sample_infector(ScalarType u, const Person& person, VirusVariant virus,
+                                                     TimePoint t, TimeSpan dt, const Parameters& global_params) const
+{
+    auto age_receiver = person.get_age();
+    auto& cells       = person.get_cells();
+    //the contacts in a cell are limited in interact, so the contribution of every infected person is limited as well
+    std::vector<ScalarType> contact_factors(cells.size());
+    std::vector<ScalarType> air_factors(cells.size());
+    for (size_t c = 0; c < cells.size(); ++c) {
+        auto contacts_per_day =
+            transmission_contacts_per_day(cells[c], virus, age_receiver, global_params.get_num_groups());
+        contact_factors[c] = contacts_per_day > m_parameters.get<MaximumContacts>()
+                                 ? m_parameters.get<MaximumContacts>() / contacts_per_day
+                                 : 1.0;
+        air_factors[c]     = global_params.get<AerosolTransmissionRates>()[{virus}];
+        if (m_capacity_adapted_transmission_risk) {
+            air_factors[c] *= m_cells[cells[c]].compute_space_per_person_relative();
+        }
+    }
+
+    //contribution of one person to the exposure of the infected person, see cache_exposure_rates
+    auto get_weight = [&](size_t i) {
+        auto&& p = m_persons[i];
+        if (p.get() == &person || !p->is_infected(t) || p->get_infection().get_virus_variant() != virus) {
+            return 0.0;
+        }
+        auto infectivity  = p->get_infection().get_infectivity(t + dt / 2);
+        auto contact_rate = m_parameters.get<ContactRates>()[{age_receiver, p->get_age()}];
+        ScalarType weight = 0.0;
+        for (auto cell_idx : m_cells_of_persons[i]) {
+            auto iter = std::find(cells.begin(), cells.end(), cell_idx);
+            if (iter != cells.end()) {
+                auto c = std::distance(cells.begin(), iter);
+                weight += infectivity * (contact_rate * contact_factors[c] + air_factors[c]);
+            }
+        }
+        return weight;
+    };
+
+    ScalarType total = 0.0;
+    for (size_t i = 0; i < m_persons.size(); ++i) {
+        total += get_weight(i);
+    }
+    auto threshold                      = u * total;
+    ScalarType sum                      = 0.0;
+    observer_ptr<const Person> infector = nullptr;
+    for (size_t i = 0; i < m_persons.size() && sum <= threshold; ++i) {
+        auto weight = get_weight(i);
+        if (weight > 0) {
+            //if the sum doesn't reach the threshold due to rounding, the last contributing person is chosen
+            infector = m_persons[i].get();
+            sum += weight;
+        }
+    }
+    return infector;
+}
+
 void Location::add_person(Person& p, std::vector<uint32_t> cells)
 {
     std::lock_guard<std::mutex> lk(m_mut);
+    for (uint32_t cell_idx : cells) {
+        assert(cell_idx < m_cells.size() && "Cell index out of range.");
+        ++m_cells[cell_idx].m_num_persons;
+    }
     m_persons.push_back(&p);
-    for (uint32_t cell_idx : cells)
-        m_cells[cell_idx].m_persons.push_back(&p);
+    m_cells_of_persons.push_back(std::move(cells));
 }
 
 void Location::remove_person(Person& p)
 {
     std::lock_guard<std::mutex> lk(m_mut);
-    m_persons.erase(std::remove(m_persons.begin(), m_persons.end(), &p), m_persons.end());
-    for (auto&& cell : m_cells) {
-        cell.m_persons.erase(std::remove(cell.m_persons.begin(), cell.m_persons.end(), &p), cell.m_persons.end());
+    auto iter = std::find(m_persons.begin(), m_persons.end(), &p);
+    if (iter != m_persons.end()) {
+        auto idx = std::distance(m_persons.begin(), iter);
+        for (uint32_t cell_idx : m_cells_of_persons[idx]) {
+            --m_cells[cell_idx].m_num_persons;
+        }
+        m_persons.erase(iter);
+        m_cells_of_persons.erase(m_cells_of_persons.begin() + idx);
     }
 }
 
@@ -157,7 +231,7 @@ size_t Location::get_number_persons() const
 For every cell in a location we have a transmission factor that is nomalized to m_capacity.volume / m_capacity.persons of 
 the location "Home", which is 66. We multiply this rate with the individual size of each cell to obtain a "space per person" factor.
 */
-ScalarType Cell::compute_space_per_person_relative()
+ScalarType Cell::compute_space_per_person_relative() const
 {
     if (m_capacity.volume != 0) {
         return 66.0 / m_capacity.volume;
@@ -167,18 +241,24 @@ ScalarType Cell::compute_space_per_person_relative()
     }
 }
 
-size_t Cell::get_subpopulation(TimePoint t, InfectionState state) const
+size_t Location::get_subpopulation(TimePoint t, InfectionState state) const
 {
     return count_if(m_persons.begin(), m_persons.end(), [&](observer_ptr<Person> p) {
         return p->get_infection_state(t) == state;
     });
 }
 
-size_t Location::get_subpopulation(TimePoint t, InfectionState state) const
+size_t Location::get_subpopulation(TimePoint t, InfectionState state, uint32_t cell_idx) const
 {
-    return count_if(m_persons.begin(), m_persons.end(), [&](observer_ptr<Person> p) {
-        return p->get_infection_state(t) == state;
-    });
+    size_t count = 0;
+    for (size_t i = 0; i < m_persons.size(); ++i) {
+        auto&& cells = m_cells_of_persons[i];
+        if (m_persons[i]->get_infection_state(t) == state &&
+            std::find(cells.begin(), cells.end(), cell_idx) != cells.end()) {
+            ++count;
+        }
+    }
+    return count;
 }
 
 } // namespace abm
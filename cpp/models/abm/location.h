@@ -29,6 +29,7 @@
 #include "memilio/epidemiology/age_group.h"
 #include "memilio/math/eigen.h"
 #include "memilio/utils/custom_index_array.h"
+#include "memilio/utils/static_index_array.h"
 #include "memilio/utils/time_series.h"
 #include "memilio/utils/memory.h"
 #include <array>
@@ -59,15 +60,17 @@ struct CellCapacity {
 /**
  * @brief The Location can be split up into several Cell%s. 
  * This allows a finer division of the people at the Location.
+ * The Person%s themselves are only stored once in the Location, the Cell only keeps track of its occupancy and
+ * the cached exposure rates of the Person%s in it.
  */
 struct Cell {
-    std::vector<observer_ptr<Person>> m_persons;
+    uint32_t m_num_persons; ///< Number of Person%s currently in the Cell.
     CustomIndexArray<ScalarType, VirusVariant, AgeGroup> m_cached_exposure_rate_contacts;
-    CustomIndexArray<ScalarType, VirusVariant> m_cached_exposure_rate_air;
+    StaticIndexArray<ScalarType, VirusVariant> m_cached_exposure_rate_air;
     CellCapacity m_capacity;
 
-    Cell(size_t num_agegroups, std::vector<observer_ptr<Person>> persons = {})
-        : m_persons(std::move(persons))
+    Cell(size_t num_agegroups)
+        : m_num_persons(0)
         , m_cached_exposure_rate_contacts({{VirusVariant::Count, AgeGroup(num_agegroups)}, 0.})
         , m_cached_exposure_rate_air({{VirusVariant::Count}, 0.})
         , m_capacity()
@@ -78,15 +81,7 @@ struct Cell {
     * @brief Computes a relative cell size for the Cell.
     * @return The relative cell size for the Cell.
     */
-    ScalarType compute_space_per_person_relative();
-
-    /**
-    * @brief Get subpopulation of a particular #InfectionState in the Cell.
-    * @param[in] t TimePoint of querry.
-    * @param[in] state #InfectionState of interest.
-    * @return Amount of Person%s of the #InfectionState in the Cell.
-    */
-    size_t get_subpopulation(TimePoint t, InfectionState state) const;
+    ScalarType compute_space_per_person_relative() const;
 
 }; // namespace mio
 
@@ -125,6 +120,7 @@ public:
         , m_capacity_adapted_transmission_risk(other.m_capacity_adapted_transmission_risk)
         , m_parameters(other.m_parameters)
         , m_persons(other.m_persons)
+        , m_cells_of_persons(other.m_cells_of_persons)
         , m_cells(other.m_cells)
         , m_required_mask(other.m_required_mask)
         , m_npi_active(other.m_npi_active)
@@ -192,6 +188,8 @@ public:
 
     /** 
      * @brief A Person interacts with the population at this Location and may become infected.
+     * If the Person is in multiple Cell%s, the exposure of all of these Cell%s is added up and a single
+     * infection event is drawn.
      * @param[in, out] rng Person::RandomNumberGenerator for this Person.
      * @param[in, out] person The Person that interacts with the population.
      * @param[in] dt Length of the current Simulation time step.
@@ -203,7 +201,7 @@ public:
     /** 
      * @brief Add a Person to the population at this Location.
      * @param[in] person The Person arriving.
-     * @param[in] cell_idx [Default: 0] Index of the Cell the Person shall go to.
+     * @param[in] cells [Default: {0}] Indices of the Cell%s the Person shall go to.
     */
     void add_person(Person& person, std::vector<uint32_t> cells = {0});
 
@@ -221,6 +219,23 @@ public:
      */
     void cache_exposure_rates(TimePoint t, TimeSpan dt, size_t num_agegroups);
 
+    /**
+     * @brief Sample the Person that infected a Person at this Location during the current Simulation step.
+     * Each infected Person at the Location is chosen with a probability proportional to its contribution to the
+     * exposure of the infected Person, i.e. its infectivity weighted with the contact and aerosol transmission rates
+     * of the Cell%s that both Person%s are in, as accumulated in cache_exposure_rates.
+     * Must be called before the Person%s migrate at the end of the step.
+     * @param[in] u Uniformly distributed random number in [0, 1) that selects the infector.
+     * @param[in] person The infected Person.
+     * @param[in] virus VirusVariant of the infection.
+     * @param[in] t Start of the current Simulation step.
+     * @param[in] dt The duration of the Simulation step.
+     * @param[in] global_params The Parameters of the Model.
+     * @return The infecting Person or nullptr if no infected Person contributes to the exposure.
+     */
+    observer_ptr<const Person> sample_infector(ScalarType u, const Person& person, VirusVariant virus, TimePoint t,
+                                               TimeSpan dt, const Parameters& global_params) const;
+
     /**
      * @brief Get the Location specific Infection parameters.
      * @return Parameters of the Infection that are specific to this Location.
@@ -277,7 +292,7 @@ public:
      * @param[in] cell_idx Cell index of interest.
      * @return Contact exposure rate in the cell.
      */
-    CustomIndexArray<ScalarType, VirusVariant> get_cached_exposure_rate_air(uint32_t cell_idx) const
+    StaticIndexArray<ScalarType, VirusVariant> get_cached_exposure_rate_air(uint32_t cell_idx) const
     {
         return m_cells[cell_idx].m_cached_exposure_rate_air;
     }
@@ -369,6 +384,16 @@ public:
      */
     size_t get_number_persons() const;
 
+    /**
+     * @brief Get the number of Person%s in a Cell of the Location.
+     * @param[in] cell_idx Cell index of interest.
+     * @return Number of Person%s in the Cell.
+     */
+    size_t get_number_persons(uint32_t cell_idx) const
+    {
+        return m_cells[cell_idx].m_num_persons;
+    }
+
     /**
      * @brief Get the number of Person%s of a particular #InfectionState for all Cell%s.
      * @param[in] t TimePoint of querry.
@@ -377,6 +402,15 @@ public:
      */
     size_t get_subpopulation(TimePoint t, InfectionState state) const;
 
+    /**
+     * @brief Get the number of Person%s of a particular #InfectionState in one Cell.
+     * @param[in] t TimePoint of querry.
+     * @param[in] state #InfectionState of interest.
+     * @param[in] cell_idx Cell index of interest.
+     * @return Amount of Person%s of the #InfectionState in the Cell.
+     */
+    size_t get_subpopulation(TimePoint t, InfectionState state, uint32_t cell_idx) const;
+
     /**
      * @brief Get the geographical location of the Location.
      * @return The geographical location of the Location.
@@ -402,6 +436,8 @@ private:
     transmission risk.*/
     LocalInfectionParameters m_parameters; ///< Infection parameters for the Location.
     std::vector<observer_ptr<Person>> m_persons{}; ///< A vector of all Person%s at the Location.
+    std::vector<std::vector<uint32_t>> m_cells_of_persons{}; /**< Indices of the Cell%s of each Person, same order
+    as m_persons.*/
     std::vector<Cell> m_cells{}; ///< A vector of all Cell%s that the Location is divided in.
     MaskType m_required_mask; ///< Least secure type of Mask that is needed to enter the Location.
     bool m_npi_active; ///< If true requires e.g. Mask%s to enter the Location.
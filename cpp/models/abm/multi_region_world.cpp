@@ -0,0 +1,161 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "abm/multi_region_world.h"
+#include "abm/step_hooks.h"
+#include "memilio/utils/logging.h"
+#include "memilio/utils/mioomp.h"
+#include "memilio/utils/stl_util.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace mio
+{
+namespace abm
+{
+
+uint32_t MultiRegionWorld::add_region(World&& world)
+{
+    m_regions.emplace_back(std::move(world));
+    for (auto& region : m_regions) {
+        region.outboxes.resize(m_regions.size());
+    }
+    return static_cast<uint32_t>(m_regions.size() - 1);
+}
+
+void MultiRegionWorld::add_trip(uint32_t origin_region, const RegionTrip& trip, bool weekend)
+{
+    assert(origin_region < m_regions.size() && trip.destination_region < m_regions.size() && "Invalid region.");
+    auto& trips = weekend ? m_regions[origin_region].trips_weekend : m_regions[origin_region].trips_weekday;
+    //sorted like the TripList
+    insert_sorted_replace(trips, trip, [](auto& trip1, auto& trip2) {
+        return std::tie(trip1.trip.time, trip1.trip.person_id) < std::tie(trip2.trip.time, trip2.trip.person_id);
+    });
+}
+
+void MultiRegionWorld::evolve(TimePoint t, TimeSpan dt)
+{
+    //Person%s can be at Location%s of other regions, so every phase must be finished in all regions
+    //before the next phase starts. Parallel loops inside of the regions are not nested by default.
+    NoHooks hooks;
+    PRAGMA_OMP(parallel for)
+    for (auto i = size_t(0); i < m_regions.size(); ++i) {
+        m_regions[i].world.begin_step(t, dt);
+    }
+    log_info("ABM MultiRegionWorld interaction.");
+    PRAGMA_OMP(parallel for)
+    for (auto i = size_t(0); i < m_regions.size(); ++i) {
+        m_regions[i].world.interaction(t, dt, hooks);
+    }
+    log_info("ABM MultiRegionWorld migration.");
+    PRAGMA_OMP(parallel for)
+    for (auto i = size_t(0); i < m_regions.size(); ++i) {
+        m_regions[i].world.migration(t, dt, hooks);
+    }
+    PRAGMA_OMP(parallel for)
+    for (auto i = size_t(0); i < m_regions.size(); ++i) {
+        m_regions[i].world.trips(t, dt, hooks);
+        send_trips(static_cast<uint32_t>(i), t, dt);
+    }
+    PRAGMA_OMP(parallel for)
+    for (auto i = size_t(0); i < m_regions.size(); ++i) {
+        receive_trips(static_cast<uint32_t>(i), t);
+    }
+}
+
+void MultiRegionWorld::send_trips(uint32_t region_idx, TimePoint t, TimeSpan dt)
+{
+    auto& region = m_regions[region_idx];
+    auto& world  = region.world;
+    auto& trips  = t.is_weekend() ? region.trips_weekend : region.trips_weekday;
+
+    auto first_trip = region.trip_index;
+    while (region.trip_index < trips.size() &&
+           trips[region.trip_index].trip.time.seconds() < (t + dt).time_since_midnight().seconds()) {
+        ++region.trip_index;
+    }
+    //a Person is only at one Location at the end of the step, so only the last Trip of each Person is made.
+    //This also ensures that no Person is handed off to two regions that are processed in parallel.
+    region.due_trips.clear();
+    for (auto i = first_trip; i < region.trip_index; ++i) {
+        region.due_trips.push_back(i);
+    }
+    std::stable_sort(region.due_trips.begin(), region.due_trips.end(), [&](auto i, auto j) {
+        return trips[i].trip.person_id < trips[j].trip.person_id;
+    });
+    for (auto k = size_t(0); k < region.due_trips.size(); ++k) {
+        auto& region_trip = trips[region.due_trips[k]];
+        auto& trip        = region_trip.trip;
+        if (k + 1 < region.due_trips.size() && trips[region.due_trips[k + 1]].trip.person_id == trip.person_id) {
+            continue;
+        }
+        auto& person = *world.m_persons[trip.person_id];
+        if (!person.is_in_quarantine(t, world.parameters) && person.get_infection_state(t) != InfectionState::Dead) {
+            region.outboxes[region_trip.destination_region].push_back(
+                {&person, trip.migration_destination, trip.trip_mode});
+        }
+    }
+
+    if (((t).days() < std::floor((t + dt).days()))) {
+        region.trip_index = 0;
+    }
+}
+
+void MultiRegionWorld::receive_trips(uint32_t region_idx, TimePoint t)
+{
+    auto& world = m_regions[region_idx].world;
+    for (auto& source : m_regions) {
+        auto& inbox = source.outboxes[region_idx];
+        for (auto& hand_off : inbox) {
+            auto& person      = *hand_off.person;
+            auto personal_rng = Person::RandomNumberGenerator(source.world.get_rng(), person);
+            auto& destination = world.get_individualized_location(hand_off.destination);
+            if (world.get_testing_strategy().run_strategy(personal_rng, person, destination, t)) {
+                person.apply_mask_intervention(personal_rng, destination);
+                person.migrate_to(destination, hand_off.mode);
+            }
+        }
+        inbox.clear();
+    }
+}
+
+size_t MultiRegionWorld::get_subpopulation_combined(TimePoint t, InfectionState s) const
+{
+    size_t count = 0;
+    for (auto& region : m_regions) {
+        count += region.world.get_subpopulation_combined(t, s);
+    }
+    return count;
+}
+
+void evolve_model(double t, double dt, MultiRegionWorld& world)
+{
+    auto t_abm = TimePoint(0) + days(t);
+    auto tmax  = TimePoint(0) + days(t + dt);
+    while (t_abm < tmax) {
+        auto step = std::min(hours(1), tmax - t_abm);
+        world.evolve(t_abm, step);
+        t_abm += step;
+    }
+}
+
+} // namespace abm
+} // namespace mio
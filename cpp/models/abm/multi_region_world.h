@@ -0,0 +1,188 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_ABM_MULTI_REGION_WORLD_H
+#define MIO_ABM_MULTI_REGION_WORLD_H
+
+#include "abm/infection_state.h"
+#include "abm/location_type.h"
+#include "abm/person.h"
+#include "abm/time.h"
+#include "abm/trip_list.h"
+#include "abm/world.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace mio
+{
+namespace abm
+{
+
+/**
+ * @brief A Trip of a Person to a Location in a different region of a MultiRegionWorld.
+ */
+struct RegionTrip {
+    uint32_t destination_region; ///< Index of the region that contains the destination of the Trip.
+    Trip trip; ///< The Trip, the Person belongs to the origin region, the destination to the destination region.
+};
+
+/**
+ * @brief A World that is split into regions, e.g. counties, with one World per region.
+ * Each region owns its Location%s and Person%s. Person%s can visit Location%s of other regions by
+ * RegionTrip%s, but always stay owned by their home region, i.e. they are updated by the home region
+ * and follow the migration rules and the TestingStrategy of their home region.
+ * The regions are stepped in parallel, one region per thread. All regions finish a phase of the step
+ * (see StepPhase) before any region starts the next phase, so a Person is only changed by one thread at a time.
+ * The RegionTrip%s are not executed directly but collected in one queue per pair of regions and handed off to
+ * the destination region in a batch at the end of the step, where the TestingStrategy of the destination region
+ * decides whether the Person may enter.
+ * The regions should use different random number generator keys, otherwise Person%s with the same index in
+ * different regions draw the same random numbers.
+ * Can be used as node property of a mio::Graph, see evolve_model(double, double, MultiRegionWorld&).
+ */
+class MultiRegionWorld
+{
+public:
+    /**
+     * @brief Create an empty MultiRegionWorld, regions need to be added later.
+     */
+    MultiRegionWorld() = default;
+
+    //type is move-only for stable references of persons/locations, like World
+    MultiRegionWorld(MultiRegionWorld&&)            = default;
+    MultiRegionWorld& operator=(MultiRegionWorld&&) = default;
+    MultiRegionWorld(const MultiRegionWorld&)       = delete;
+    MultiRegionWorld& operator=(const MultiRegionWorld&) = delete;
+
+    /**
+     * @brief Add a region.
+     * @param[in] world The World of the region.
+     * @return Index of the new region.
+     */
+    uint32_t add_region(World&& world);
+
+    /**
+     * @brief Get the number of regions.
+     */
+    size_t get_num_regions() const
+    {
+        return m_regions.size();
+    }
+
+    /**
+     * @brief Get the World of a region.
+     * @param[in] region Index of the region.
+     * @{
+     */
+    World& get_region(uint32_t region)
+    {
+        return m_regions[region].world;
+    }
+    const World& get_region(uint32_t region) const
+    {
+        return m_regions[region].world;
+    }
+    /**@}*/
+
+    /**
+     * @brief Add a Trip to a Location in a different region.
+     * Trips inside of a region are added to the TripList of the World of the region.
+     * @param[in] origin_region Index of the region that the Person of the Trip belongs to.
+     * @param[in] trip The Trip and the region of its destination.
+     * @param[in] weekend If the Trip is made on a weekend day.
+     */
+    void add_trip(uint32_t origin_region, const RegionTrip& trip, bool weekend = false);
+
+    /**
+     * @brief Get the number of Trip%s of Person%s of a region to other regions.
+     * @param[in] origin_region Index of the region.
+     * @param[in] weekend Whether the Trip%s during the week or on the weekend are counted.
+     */
+    size_t get_num_trips(uint32_t origin_region, bool weekend = false) const
+    {
+        return weekend ? m_regions[origin_region].trips_weekend.size()
+                       : m_regions[origin_region].trips_weekday.size();
+    }
+
+    /**
+     * @brief Evolve all regions one time step.
+     * @param[in] t Current time.
+     * @param[in] dt Length of the time step.
+     */
+    void evolve(TimePoint t, TimeSpan dt);
+
+    /**
+     * @brief Get the number of Person%s of all regions in one #InfectionState.
+     * @param[in] t Specified #TimePoint.
+     * @param[in] s Specified #InfectionState.
+     */
+    size_t get_subpopulation_combined(TimePoint t, InfectionState s) const;
+
+private:
+    /**
+     * @brief A Person that enters a Location of a different region.
+     * The Person belongs to the region that sends the HandOff.
+     */
+    struct HandOff {
+        Person* person;
+        LocationId destination; ///< Location in the receiving region.
+        TransportMode mode;
+    };
+
+    struct Region {
+        World world;
+        std::vector<RegionTrip> trips_weekday;
+        std::vector<RegionTrip> trips_weekend;
+        size_t trip_index = 0;
+        std::vector<size_t> due_trips; ///< Indices of the RegionTrip%s of the current step.
+        std::vector<std::vector<HandOff>> outboxes; ///< Hand-offs to each region, filled by this region.
+
+        Region(World&& w)
+            : world(std::move(w))
+        {
+        }
+    };
+
+    /**
+     * @brief Collect the RegionTrip%s of a region that are due in this time step in the outboxes.
+     */
+    void send_trips(uint32_t region_idx, TimePoint t, TimeSpan dt);
+
+    /**
+     * @brief Let the Person%s that were handed off to a region enter their destination.
+     */
+    void receive_trips(uint32_t region_idx, TimePoint t);
+
+    std::vector<Region> m_regions;
+};
+
+/**
+ * @brief Evolve a MultiRegionWorld in a mio::GraphSimulation.
+ * Time is measured in days like in the ODE models. The MultiRegionWorld is evolved in steps of one hour.
+ * @param[in] t Current time in days.
+ * @param[in] dt Length of the time step in days.
+ * @param[in, out] world The node property.
+ */
+void evolve_model(double t, double dt, MultiRegionWorld& world);
+
+} // namespace abm
+} // namespace mio
+
+#endif // MIO_ABM_MULTI_REGION_WORLD_H
@@ -56,7 +56,7 @@ Person Person::copy_person(Location& location)
 {
     Person copied_person     = Person(*this);
     copied_person.m_location = &location;
-    location.add_person(*this);
+    location.add_person(*this, m_cells);
     return copied_person;
 }
 
@@ -70,7 +70,8 @@ void Person::interact(RandomNumberGenerator& rng, TimePoint t, TimeSpan dt, cons
 
 void Person::migrate_to(Location& loc_new, mio::abm::TransportMode transport_mode, const std::vector<uint32_t>& cells)
 {
-    if (*m_location != loc_new) {
+    //compare the objects, not the ids, the Location may belong to a different World, see MultiRegionWorld
+    if (m_location.get() != &loc_new) {
         m_location->remove_person(*this);
         m_location = &loc_new;
         m_cells    = cells;
@@ -209,7 +210,7 @@ bool Person::get_tested(RandomNumberGenerator& rng, TimePoint t, const TestParam
     }
 }
 
-uint32_t Person::get_person_id()
+uint32_t Person::get_person_id() const
 {
     return m_person_id;
 }
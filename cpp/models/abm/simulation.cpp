@@ -34,12 +34,5 @@ Simulation::Simulation(TimePoint t, World&& world)
 {
 }
 
-void Simulation::evolve_world(TimePoint tmax)
-{
-    auto dt = std::min(m_dt, tmax - m_t);
-    m_world.evolve(m_t, dt);
-    m_t += m_dt;
-}
-
 } // namespace abm
 } // namespace mio
@@ -21,6 +21,7 @@
 #define EPI_ABM_SIMULATOR_H
 
 #include "abm/world.h"
+#include "abm/step_hooks.h"
 #include "abm/time.h"
 #include "memilio/utils/time_series.h"
 #include "memilio/compartments/compartmentalmodel.h"
@@ -64,11 +65,25 @@ public:
      */
     template <typename... History>
     void advance(TimePoint tmax, History&... history)
+    {
+        NoHooks hooks;
+        advance_with_hooks(tmax, hooks, history...);
+    }
+
+    /** 
+     * @brief Run the Simulation from the current time to tmax and report the events of each step to hooks.
+     * @param[in] tmax Time to stop.
+     * @param[in, out] hooks Callbacks for infection, test and migration events, see NoHooks.
+     * @param[in] history History object to log data of the Simulation.
+     * @tparam Hooks Type that defines (some of) the callbacks, see NoHooks.
+     */
+    template <class Hooks, typename... History>
+    void advance_with_hooks(TimePoint tmax, Hooks& hooks, History&... history)
     {
         //log initial system state
         (history.log(*this), ...);
         while (m_t < tmax) {
-            evolve_world(tmax);
+            evolve_world(tmax, hooks);
             (history.log(*this), ...);
         }
     }
@@ -95,7 +110,14 @@ public:
 
 private:
     void store_result_at(TimePoint t);
-    void evolve_world(TimePoint tmax);
+
+    template <class Hooks>
+    void evolve_world(TimePoint tmax, Hooks& hooks)
+    {
+        auto dt = std::min(m_dt, tmax - m_t);
+        m_world.evolve(m_t, dt, hooks);
+        m_t += m_dt;
+    }
 
     World m_world; ///< The World to simulate.
     TimePoint m_t; ///< The current TimePoint of the Simulation.
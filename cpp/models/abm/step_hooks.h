@@ -0,0 +1,114 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_ABM_STEP_HOOKS_H
+#define MIO_ABM_STEP_HOOKS_H
+
+#include "abm/person.h"
+#include "abm/location.h"
+#include "abm/time.h"
+#include "memilio/utils/metaprogramming.h"
+
+namespace mio
+{
+namespace abm
+{
+
+/**
+ * @brief Phases of a time step of the World.
+ */
+enum class StepPhase
+{
+    BeginStep, ///< Preparation of the step, e.g. caching of exposure rates.
+    Interaction, ///< Person%s may become infected at their Location.
+    Migration, ///< Person%s move according to the migration rules.
+    Trips, ///< Person%s make the Trip%s of the TripList.
+};
+
+/**
+ * @brief Hooks that do nothing.
+ * Default hooks of World::evolve and Simulation::advance.
+ *
+ * Hooks are a policy type that is passed to World::evolve or Simulation::advance_with_hooks to observe single events
+ * during a time step. A type used as hooks may define any of the following member functions:
+ * - `void on_infection(Person::RandomNumberGenerator& rng, const Person& person, const Location& location,
+ *   TimePoint t, TimeSpan dt)` is called after a Person was infected at a Location during the step [t, t + dt).
+ *   The random number generator of the infected Person is passed along, e.g. to sample the source of the infection.
+ * - `void on_test(const Person& person, const Location& location, TimePoint t, bool positive)` is called after a
+ *   Person was tested when trying to enter a Location.
+ * - `void on_migration(const Person& person, const Location& origin, const Location& destination, TimePoint t)` is
+ *   called after a Person migrated from one Location to another.
+ * - `void on_phase_end(StepPhase phase, TimePoint t, TimeSpan dt)` is called after a phase of the step is finished
+ *   for all Person%s. It is not called concurrently.
+ * Member functions that are not defined are never called, the detection of the events is removed at compile time.
+ * So the hooks have no overhead if they are not used.
+ * The hooks are called concurrently from multiple threads if multithreading is enabled.
+ */
+struct NoHooks {
+};
+
+/**
+ * Detect whether certain member functions of hooks exist.
+ * If the member function exists in the type H, this template when instantiated
+ * will be equal to the return type of the function. Otherwise the template is invalid.
+ * @tparam H Any class, e.g. NoHooks.
+ * @{
+ */
+template <class H>
+using on_infection_expr_t = decltype(std::declval<H&>().on_infection(
+    std::declval<Person::RandomNumberGenerator&>(), std::declval<const Person&>(), std::declval<const Location&>(),
+    std::declval<TimePoint>(), std::declval<TimeSpan>()));
+
+template <class H>
+using on_test_expr_t = decltype(std::declval<H&>().on_test(std::declval<const Person&>(),
+                                                            std::declval<const Location&>(),
+                                                            std::declval<TimePoint>(), std::declval<bool>()));
+
+template <class H>
+using on_migration_expr_t =
+    decltype(std::declval<H&>().on_migration(std::declval<const Person&>(), std::declval<const Location&>(),
+                                             std::declval<const Location&>(), std::declval<TimePoint>()));
+
+template <class H>
+using on_phase_end_expr_t = decltype(std::declval<H&>().on_phase_end(
+    std::declval<StepPhase>(), std::declval<TimePoint>(), std::declval<TimeSpan>()));
+/** @} */
+
+/**
+ * Template meta functions to check if hooks define a certain callback.
+ * @tparam H Any class, e.g. NoHooks.
+ * @{
+ */
+template <class H>
+constexpr bool has_infection_hook_v = is_expression_valid<on_infection_expr_t, H>::value;
+
+template <class H>
+constexpr bool has_test_hook_v = is_expression_valid<on_test_expr_t, H>::value;
+
+template <class H>
+constexpr bool has_migration_hook_v = is_expression_valid<on_migration_expr_t, H>::value;
+
+template <class H>
+constexpr bool has_phase_end_hook_v = is_expression_valid<on_phase_end_expr_t, H>::value;
+/** @} */
+
+} // namespace abm
+} // namespace mio
+
+#endif // MIO_ABM_STEP_HOOKS_H
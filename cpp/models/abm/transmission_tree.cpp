@@ -0,0 +1,123 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "abm/transmission_tree.h"
+#include "abm/infection.h"
+#include "memilio/utils/mioomp.h"
+#include "memilio/utils/random_number_generator.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace mio
+{
+namespace abm
+{
+
+TransmissionTreeRecorder::TransmissionTreeRecorder(const Parameters& params, size_t capacity_per_thread)
+    : m_parameters(params)
+    , m_pending(get_omp_max_threads())
+    , m_events(get_omp_max_threads())
+{
+    for (auto& pending : m_pending) {
+        pending.reserve(capacity_per_thread);
+    }
+    for (auto& events : m_events) {
+        events.reserve(capacity_per_thread);
+    }
+}
+
+void TransmissionTreeRecorder::on_infection(Person::RandomNumberGenerator& rng, const Person& person,
+                                            const Location& location, TimePoint /*t*/, TimeSpan /*dt*/)
+{
+    auto u = UniformDistribution<double>::get_instance()(rng);
+    m_pending[get_omp_thread_id()].push_back({&person, &location, u});
+}
+
+void TransmissionTreeRecorder::on_phase_end(StepPhase phase, TimePoint t, TimeSpan dt)
+{
+    if (phase != StepPhase::Interaction) {
+        return;
+    }
+    PRAGMA_OMP(parallel for)
+    for (auto i = size_t(0); i < m_pending.size(); ++i) {
+        for (auto&& pending : m_pending[i]) {
+            auto& location = *pending.location;
+            auto virus     = pending.person->get_infection().get_virus_variant();
+            auto infector  = location.sample_infector(pending.u, *pending.person, virus, t, dt, m_parameters);
+            m_events[i].push_back({pending.person->get_person_id(),
+                                   infector ? infector->get_person_id() : INVALID_PERSON_ID, location.get_index(),
+                                   static_cast<uint32_t>(location.get_type()), static_cast<uint32_t>(virus),
+                                   (t + dt / 2).seconds()});
+        }
+        m_pending[i].clear();
+    }
+}
+
+std::vector<TransmissionEvent> TransmissionTreeRecorder::get_events() const
+{
+    std::vector<TransmissionEvent> events;
+    for (auto&& thread_events : m_events) {
+        events.insert(events.end(), thread_events.begin(), thread_events.end());
+    }
+    //the order of the threads is arbitrary, sort so the output is reproducible
+    std::sort(events.begin(), events.end(), [](auto&& a, auto&& b) {
+        return std::make_pair(a.time, a.infected_id) < std::make_pair(b.time, b.infected_id);
+    });
+    return events;
+}
+
+IOResult<void> TransmissionTreeRecorder::flush(const std::string& filename)
+{
+    std::ofstream ofs(filename, std::ios::binary | std::ios::app);
+    if (!ofs.is_open()) {
+        return failure(StatusCode::FileNotFound, filename);
+    }
+    auto events = get_events();
+    ofs.write(reinterpret_cast<const char*>(events.data()), events.size() * sizeof(TransmissionEvent));
+    if (!ofs) {
+        return failure(StatusCode::UnknownError, "Unknown error writing transmission tree.");
+    }
+    for (auto& thread_events : m_events) {
+        thread_events.clear();
+    }
+    return success();
+}
+
+IOResult<std::vector<TransmissionEvent>> read_transmission_tree(const std::string& filename)
+{
+    std::ifstream ifs(filename, std::ios::binary | std::ios::ate);
+    if (!ifs.is_open()) {
+        return failure(StatusCode::FileNotFound, filename);
+    }
+    auto size = static_cast<size_t>(ifs.tellg());
+    if (size % sizeof(TransmissionEvent) != 0) {
+        return failure(StatusCode::InvalidFileFormat, filename + " is not a transmission tree.");
+    }
+    std::vector<TransmissionEvent> events(size / sizeof(TransmissionEvent));
+    ifs.seekg(0);
+    ifs.read(reinterpret_cast<char*>(events.data()), size);
+    if (!ifs) {
+        return failure(StatusCode::UnknownError, "Unknown error reading transmission tree.");
+    }
+    return success(std::move(events));
+}
+
+} // namespace abm
+} // namespace mio
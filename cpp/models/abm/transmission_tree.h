@@ -0,0 +1,141 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#ifndef MIO_ABM_TRANSMISSION_TREE_H
+#define MIO_ABM_TRANSMISSION_TREE_H
+
+#include "abm/location.h"
+#include "abm/parameters.h"
+#include "abm/person.h"
+#include "abm/step_hooks.h"
+#include "abm/time.h"
+#include "memilio/io/io.h"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace mio
+{
+namespace abm
+{
+
+/**
+ * @brief A single transmission, i.e. an edge of the transmission tree.
+ * Plain data with a fixed layout that is written to and read from binary files as is.
+ */
+struct TransmissionEvent {
+    uint32_t infected_id; ///< Id of the infected Person.
+    uint32_t infector_id; ///< Id of the infecting Person or INVALID_PERSON_ID if no infector could be found.
+    uint32_t location_index; ///< Index of the Location where the transmission happened.
+    uint32_t location_type; ///< LocationType of the Location where the transmission happened.
+    uint32_t virus; ///< VirusVariant that was transmitted.
+    int32_t time; ///< Time of the transmission in seconds since the start of the simulation.
+
+    bool operator==(const TransmissionEvent& other) const
+    {
+        return infected_id == other.infected_id && infector_id == other.infector_id &&
+               location_index == other.location_index && location_type == other.location_type &&
+               virus == other.virus && time == other.time;
+    }
+};
+
+static_assert(std::is_trivially_copyable<TransmissionEvent>::value && sizeof(TransmissionEvent) == 24,
+              "TransmissionEvent must be a compact plain data type to be written to binary files.");
+
+/**
+ * @brief Records who infected whom during a Simulation.
+ * Hooks for World::evolve and Simulation::advance_with_hooks, see NoHooks.
+ * For every new infection, the infecting Person is sampled from all infected Person%s that share a Cell with the
+ * infected Person, weighted by their contribution to the exposure rates of the Cell%s (see
+ * Location::cache_exposure_rates). Sampling uses the random number generator of the infected Person, so a
+ * Simulation with recording produces a different (but equally valid) realization than one without recording.
+ * The infections are collected during the interaction and the infectors are sampled afterwards,
+ * when the Person%s don't change anymore, so the recording is safe with multiple threads.
+ * Each thread writes into its own preallocated buffer.
+ * Simulations that don't use the recorder are not affected at all.
+ */
+class TransmissionTreeRecorder
+{
+public:
+    /**
+     * @brief Create a TransmissionTreeRecorder.
+     * @param[in] params Global infection parameters of the World.
+     * @param[in] capacity_per_thread Number of events that can be stored per thread without reallocation.
+     */
+    TransmissionTreeRecorder(const Parameters& params, size_t capacity_per_thread = 1024);
+
+    /**
+     * @brief Remember a new infection, the infector is sampled at the end of the interaction.
+     * @param[in, out] rng Person::RandomNumberGenerator of the infected Person.
+     * @param[in] person The infected Person.
+     * @param[in] location Location where the Person was infected.
+     * @param[in] t Start of the time step.
+     * @param[in] dt Length of the time step.
+     */
+    void on_infection(Person::RandomNumberGenerator& rng, const Person& person, const Location& location,
+                      TimePoint t, TimeSpan dt);
+
+    /**
+     * @brief Sample the infectors of all infections of the time step after the interaction.
+     * @param[in] phase The phase of the step that is finished.
+     * @param[in] t Start of the time step.
+     * @param[in] dt Length of the time step.
+     */
+    void on_phase_end(StepPhase phase, TimePoint t, TimeSpan dt);
+
+    /**
+     * @brief Get all recorded events that were not yet written to a file.
+     * @return Events sorted by time and id of the infected Person.
+     */
+    std::vector<TransmissionEvent> get_events() const;
+
+    /**
+     * @brief Append all recorded events to a binary file and clear the buffers.
+     * The file contains only the TransmissionEvent%s sorted by time, without any header, so the file can be
+     * appended to repeatedly, e.g. after each day of the Simulation.
+     * @param[in] filename Path of the file.
+     * @return Nothing if successful, error code otherwise.
+     */
+    IOResult<void> flush(const std::string& filename);
+
+private:
+    struct PendingInfection {
+        const Person* person;
+        const Location* location;
+        ScalarType u; ///< Uniform random number in [0, 1) that selects the infector.
+    };
+
+    const Parameters& m_parameters;
+    std::vector<std::vector<PendingInfection>> m_pending; ///< Infections of the current step, one buffer per thread.
+    std::vector<std::vector<TransmissionEvent>> m_events; ///< Recorded transmissions, one buffer per thread.
+};
+
+/**
+ * @brief Read a transmission tree that was written by TransmissionTreeRecorder::flush.
+ * @param[in] filename Path of the file.
+ * @return All TransmissionEvent%s in the file if successful, error code otherwise.
+ */
+IOResult<std::vector<TransmissionEvent>> read_transmission_tree(const std::string& filename);
+
+} // namespace abm
+} // namespace mio
+
+#endif // MIO_ABM_TRANSMISSION_TREE_H
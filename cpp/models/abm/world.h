@@ -28,6 +28,10 @@
 #include "abm/lockdown_rules.h"
 #include "abm/trip_list.h"
 #include "abm/testing_strategy.h"
+#include "abm/migration_rules.h"
+#include "abm/step_hooks.h"
+#include "memilio/utils/logging.h"
+#include "memilio/utils/mioomp.h"
 #include "memilio/utils/pointer_dereferencing_iterator.h"
 #include "memilio/utils/random_number_generator.h"
 #include "memilio/utils/stl_util.h"
@@ -162,6 +166,28 @@ public:
      */
     void evolve(TimePoint t, TimeSpan dt);
 
+    /** 
+     * @brief Evolve the world one time step and report the events of the step to hooks.
+     * @param[in] t Current time.
+     * @param[in] dt Length of the time step.
+     * @param[in, out] hooks Callbacks for infection, test and migration events.
+     * @tparam Hooks Type that defines (some of) the callbacks, see NoHooks.
+     */
+    template <class Hooks>
+    void evolve(TimePoint t, TimeSpan dt, Hooks& hooks)
+    {
+        begin_step(t, dt);
+        end_phase(StepPhase::BeginStep, t, dt, hooks);
+        log_info("ABM World interaction.");
+        interaction(t, dt, hooks);
+        end_phase(StepPhase::Interaction, t, dt, hooks);
+        log_info("ABM World migration.");
+        migration(t, dt, hooks);
+        end_phase(StepPhase::Migration, t, dt, hooks);
+        trips(t, dt, hooks);
+        end_phase(StepPhase::Trips, t, dt, hooks);
+    }
+
     /** 
      * @brief Add a Location to the World.
      * @param[in] type Type of Location to add.
@@ -308,14 +334,185 @@ private:
      * @brief Person%s interact at their Location and may become infected.
      * @param[in] t The current TimePoint.
      * @param[in] dt The length of the time step of the Simulation.
+     * @param[in, out] hooks Callbacks for events, see NoHooks.
      */
-    void interaction(TimePoint t, TimeSpan dt);
+    template <class Hooks>
+    void interaction(TimePoint t, TimeSpan dt, Hooks& hooks)
+    {
+        PRAGMA_OMP(parallel for)
+        for (auto i = size_t(0); i < m_persons.size(); ++i) {
+            auto&& person     = m_persons[i];
+            auto personal_rng = Person::RandomNumberGenerator(m_rng, *person);
+            if constexpr (has_infection_hook_v<Hooks>) {
+                auto was_susceptible = person->get_infection_state(t) == InfectionState::Susceptible;
+                person->interact(personal_rng, t, dt, parameters);
+                if (was_susceptible && person->get_infection_state(t + dt) != InfectionState::Susceptible) {
+                    hooks.on_infection(personal_rng, *person, person->get_location(), t, dt);
+                }
+            }
+            else {
+                person->interact(personal_rng, t, dt, parameters);
+            }
+        }
+    }
+
     /**
      * @brief Person%s move in the World according to rules.
      * @param[in] t The current TimePoint.
      * @param[in] dt The length of the time step of the Simulation.
+     * @param[in, out] hooks Callbacks for events, see NoHooks.
+     */
+    template <class Hooks>
+    void migration(TimePoint t, TimeSpan dt, Hooks& hooks)
+    {
+        PRAGMA_OMP(parallel for)
+        for (auto i = size_t(0); i < m_persons.size(); ++i) {
+            auto&& person     = m_persons[i];
+            auto personal_rng = Person::RandomNumberGenerator(m_rng, *person);
+
+            auto try_migration_rule = [&](auto rule) -> bool {
+                //run migration rule and check if migration can actually happen
+                auto target_type       = rule(personal_rng, *person, t, dt, parameters);
+                auto& current_location = person->get_location();
+                //a Person that visits a Location of another World (see MultiRegionWorld) stays there,
+                //unless the rule sends the Person to a different type of Location
+                if (target_type == current_location.get_type() && !is_own_location(current_location)) {
+                    return false;
+                }
+                auto& target_location = find_location(target_type, *person);
+                if (run_testing_strategy(personal_rng, *person, target_location, t, hooks)) {
+                    if (&target_location != &current_location &&
+                        target_location.get_number_persons() < target_location.get_capacity().persons) {
+                        bool wears_mask = person->apply_mask_intervention(personal_rng, target_location);
+                        if (wears_mask) {
+                            migrate(*person, target_location, TransportMode::Unknown, t, hooks);
+                        }
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            //run migration rules one after the other if the corresponding location type exists
+            //shortcutting of bool operators ensures the rules stop after the first rule is applied
+            if (m_use_migration_rules) {
+                (has_locations({LocationType::Cemetery}) && try_migration_rule(&get_buried)) ||
+                    (has_locations({LocationType::Home}) && try_migration_rule(&return_home_when_recovered)) ||
+                    (has_locations({LocationType::Hospital}) && try_migration_rule(&go_to_hospital)) ||
+                    (has_locations({LocationType::ICU}) && try_migration_rule(&go_to_icu)) ||
+                    (has_locations({LocationType::School, LocationType::Home}) && try_migration_rule(&go_to_school)) ||
+                    (has_locations({LocationType::Work, LocationType::Home}) && try_migration_rule(&go_to_work)) ||
+                    (has_locations({LocationType::BasicsShop, LocationType::Home}) &&
+                     try_migration_rule(&go_to_shop)) ||
+                    (has_locations({LocationType::SocialEvent, LocationType::Home}) &&
+                     try_migration_rule(&go_to_event)) ||
+                    (has_locations({LocationType::Home}) && try_migration_rule(&go_to_quarantine));
+            }
+            else {
+                //no daily routine migration, just infection related
+                (has_locations({LocationType::Cemetery}) && try_migration_rule(&get_buried)) ||
+                    (has_locations({LocationType::Home}) && try_migration_rule(&return_home_when_recovered)) ||
+                    (has_locations({LocationType::Hospital}) && try_migration_rule(&go_to_hospital)) ||
+                    (has_locations({LocationType::ICU}) && try_migration_rule(&go_to_icu)) ||
+                    (has_locations({LocationType::Home}) && try_migration_rule(&go_to_quarantine));
+            }
+        }
+    }
+
+    /**
+     * @brief Person%s make the Trip%s of the TripList that are due in this time step.
+     * @param[in] t The current TimePoint.
+     * @param[in] dt The length of the time step of the Simulation.
+     * @param[in, out] hooks Callbacks for events, see NoHooks.
+     */
+    template <class Hooks>
+    void trips(TimePoint t, TimeSpan dt, Hooks& hooks)
+    {
+        bool weekend     = t.is_weekend();
+        size_t num_trips = m_trip_list.num_trips(weekend);
+
+        if (num_trips != 0) {
+            while (m_trip_list.get_current_index() < num_trips &&
+                   m_trip_list.get_next_trip_time(weekend).seconds() < (t + dt).time_since_midnight().seconds()) {
+                auto& trip        = m_trip_list.get_next_trip(weekend);
+                auto& person      = m_persons[trip.person_id];
+                auto personal_rng = Person::RandomNumberGenerator(m_rng, *person);
+                if (!person->is_in_quarantine(t, parameters) &&
+                    person->get_infection_state(t) != InfectionState::Dead) {
+                    auto& target_location = get_individualized_location(trip.migration_destination);
+                    if (run_testing_strategy(personal_rng, *person, target_location, t, hooks)) {
+                        person->apply_mask_intervention(personal_rng, target_location);
+                        migrate(*person, target_location, trip.trip_mode, t, hooks);
+                    }
+                }
+                m_trip_list.increase_index();
+            }
+        }
+        if (((t).days() < std::floor((t + dt).days()))) {
+            m_trip_list.reset_index();
+        }
+    }
+
+    /**
+     * @brief Run the TestingStrategy for a Person that wants to enter a Location.
+     * Reports the test to the hooks if the Person was tested.
+     * @return True if the Person is allowed to enter the Location.
+     */
+    template <class Hooks>
+    bool run_testing_strategy(Person::RandomNumberGenerator& rng, Person& person, const Location& location,
+                              TimePoint t, Hooks& hooks)
+    {
+        if constexpr (has_test_hook_v<Hooks>) {
+            auto time_of_last_test = person.get_time_of_last_test();
+            auto allowed           = m_testing_strategy.run_strategy(rng, person, location, t);
+            if (person.get_time_of_last_test() != time_of_last_test) {
+                //a tested person is only refused entry if the test is positive
+                hooks.on_test(person, location, t, !allowed);
+            }
+            return allowed;
+        }
+        else {
+            return m_testing_strategy.run_strategy(rng, person, location, t);
+        }
+    }
+
+    /**
+     * @brief Check if a Location belongs to this World.
+     */
+    bool is_own_location(const Location& location) const
+    {
+        return location.get_index() < m_locations.size() && m_locations[location.get_index()].get() == &location;
+    }
+
+    /**
+     * @brief Report the end of a phase of the step to the hooks.
      */
-    void migration(TimePoint t, TimeSpan dt);
+    template <class Hooks>
+    void end_phase(StepPhase phase, TimePoint t, TimeSpan dt, Hooks& hooks)
+    {
+        if constexpr (has_phase_end_hook_v<Hooks>) {
+            hooks.on_phase_end(phase, t, dt);
+        }
+    }
+
+    /**
+     * @brief Move a Person to a Location.
+     * Reports the migration to the hooks if the Person changed its Location.
+     */
+    template <class Hooks>
+    void migrate(Person& person, Location& destination, TransportMode mode, TimePoint t, Hooks& hooks)
+    {
+        if constexpr (has_migration_hook_v<Hooks>) {
+            auto& origin = person.get_location();
+            if (&origin != &destination) {
+                person.migrate_to(destination, mode);
+                hooks.on_migration(person, origin, destination, t);
+            }
+        }
+        else {
+            person.migrate_to(destination, mode);
+        }
+    }
 
     std::vector<std::unique_ptr<Person>> m_persons; ///< Vector with pointers to every Person.
     std::vector<std::unique_ptr<Location>> m_locations; ///< Vector with pointers to every Location.
@@ -330,6 +527,9 @@ private:
         m_migration_rules; ///< Rules that govern the migration between Location%s.
     LocationId m_cemetery_id; // Central cemetery for all dead persons.
     RandomNumberGenerator m_rng; ///< Global random number generator
+
+    //steps the phases of its shards separately
+    friend class MultiRegionWorld;
 };
 
 } // namespace abm
@@ -77,6 +77,9 @@ public:
         AgeGroup n_agegroups = params.get_num_groups();
 
         ContactMatrixGroup const& contact_matrix = params.get<ContactPatterns>();
+        //all coefficients are needed, so evaluate the dampings only once
+        auto& cont_freq = m_cont_freq;
+        contact_matrix.get_matrix_at(t, cont_freq);
 
         auto icu_occupancy           = 0.0;
         auto test_and_trace_required = 0.0;
@@ -118,8 +121,7 @@ public:
                     (1 + params.get<Seasonality>() *
                              sin(3.141592653589793 * (std::fmod((params.get<StartDay>() + t), 365.0) / 182.5 + 0.5)));
                 double cont_freq_eff =
-                    season_val * contact_matrix.get_matrix_at(t)(static_cast<Eigen::Index>((size_t)i),
-                                                                 static_cast<Eigen::Index>((size_t)j));
+                    season_val * cont_freq(static_cast<Eigen::Index>((size_t)i), static_cast<Eigen::Index>((size_t)j));
                 double Nj =
                     pop[Sj] + pop[Ej] + pop[INSj] + pop[ISyj] + pop[ISevj] + pop[ICrj] + pop[Rj]; // without died people
                 double divNj   = 1.0 / Nj; // precompute 1.0/Nj
@@ -216,6 +218,9 @@ public:
             },
             par, pop);
     }
+
+private:
+    mutable Eigen::MatrixXd m_cont_freq; ///< Workspace for the contact matrix evaluated in get_flows.
 };
 
 //forward declaration, see below.
@@ -400,6 +405,8 @@ IOResult<ScalarType> get_reproduction_number(size_t t_idx, const Simulation<Base
                                                182.5 +
                                            0.5)));
     ContactMatrixGroup const& contact_matrix = sim.get_model().parameters.template get<ContactPatterns>();
+    Eigen::MatrixXd cont_freq;
+    contact_matrix.get_matrix_at(static_cast<double>(t_idx), cont_freq);
 
     Eigen::MatrixXd cont_freq_eff(num_groups, num_groups);
     Eigen::MatrixXd riskFromInfectedSymptomatic_derivatives(num_groups, num_groups);
@@ -451,8 +458,7 @@ IOResult<ScalarType> get_reproduction_number(size_t t_idx, const Simulation<Base
 
         for (Eigen::Index l = 0; l < (Eigen::Index)num_groups; l++) {
             cont_freq_eff(l, (size_t)k) =
-                season_val * contact_matrix.get_matrix_at(static_cast<double>(t_idx))(
-                                 static_cast<Eigen::Index>((size_t)l), static_cast<Eigen::Index>((size_t)k));
+                season_val * cont_freq(static_cast<Eigen::Index>((size_t)l), static_cast<Eigen::Index>((size_t)k));
         }
     }
 
@@ -592,9 +598,7 @@ IOResult<ScalarType> get_reproduction_number(ScalarType t_value, const Simulatio
         return mio::success(get_reproduction_number((size_t)0, sim).value());
     }
 
-    const auto& times = sim.get_result().get_times();
-
-    auto time_late = std::distance(times.begin(), std::lower_bound(times.begin(), times.end(), t_value));
+    auto time_late = sim.get_result().lower_bound_time(t_value);
 
     ScalarType y1 = get_reproduction_number(static_cast<size_t>(time_late - 1), sim).value();
     ScalarType y2 = get_reproduction_number(static_cast<size_t>(time_late), sim).value();
@@ -107,6 +107,9 @@ public:
         AgeGroup n_agegroups = params.get_num_groups();
 
         ContactMatrixGroup const& contact_matrix = params.get<ContactPatterns>();
+        //all coefficients are needed, so evaluate the dampings only once
+        auto& cont_freq = m_cont_freq;
+        contact_matrix.get_matrix_at(t, cont_freq);
 
         auto icu_occupancy           = 0.0;
         auto test_and_trace_required = 0.0;
@@ -222,8 +225,7 @@ public:
                     (1 + params.get<Seasonality>() *
                              sin(3.141592653589793 * (std::fmod((params.get<StartDay>() + t), 365.0) / 182.5 + 0.5)));
                 double cont_freq_eff =
-                    season_val * contact_matrix.get_matrix_at(t)(static_cast<Eigen::Index>((size_t)i),
-                                                                 static_cast<Eigen::Index>((size_t)j));
+                    season_val * cont_freq(static_cast<Eigen::Index>((size_t)i), static_cast<Eigen::Index>((size_t)j));
                 // without died people
                 double Nj = pop[SNj] + pop[ENj] + pop[INSNj] + pop[ISyNj] + pop[ISevNj] + pop[ICrNj] + pop[INSNCj] +
                             pop[ISyNCj] + pop[SPIj] + pop[EPIj] + pop[INSPIj] + pop[ISyPIj] + pop[ISevPIj] +
@@ -512,6 +514,9 @@ public:
             },
             par, pop);
     }
+
+private:
+    mutable Eigen::MatrixXd m_cont_freq; ///< Workspace for the contact matrix evaluated in get_flows.
 };
 
 //forward declaration, see below.
@@ -561,7 +566,7 @@ public:
     * @param [in] base_infectiousness The base infectiousness of the old variant for each age group.
     */
 
-    void apply_variant(const double t, const CustomIndexArray<UncertainValue, AgeGroup> base_infectiousness)
+    void apply_variant(const double t, const CustomIndexArray<UncertainValue, AgeGroup>& base_infectiousness)
     {
         auto start_day             = this->get_model().parameters.template get<StartDay>();
         auto start_day_new_variant = this->get_model().parameters.template get<StartDayNewVariant>();
@@ -75,6 +75,23 @@ public:
             (1.0 / params.get<TimeInfected>()) * y[(size_t)InfectionState::Infected];
     }
 
+    void get_flow_jacobian(Eigen::Ref<const Eigen::VectorXd> y, double t,
+                           Eigen::Ref<Eigen::MatrixXd> jac) const override
+    {
+        auto& params     = this->parameters;
+        double coeffStoE = params.get<ContactPatterns>().get_matrix_at(t)(0, 0) *
+                           params.get<TransmissionProbabilityOnContact>() / populations.get_total();
+
+        const auto SE = get_flat_flow_index<InfectionState::Susceptible, InfectionState::Exposed>();
+        const auto EI = get_flat_flow_index<InfectionState::Exposed, InfectionState::Infected>();
+        const auto IR = get_flat_flow_index<InfectionState::Infected, InfectionState::Recovered>();
+        jac.setZero();
+        jac(SE, (size_t)InfectionState::Susceptible) = coeffStoE * y[(size_t)InfectionState::Infected];
+        jac(SE, (size_t)InfectionState::Infected)    = coeffStoE * y[(size_t)InfectionState::Susceptible];
+        jac(EI, (size_t)InfectionState::Exposed)     = 1.0 / params.get<TimeExposed>();
+        jac(IR, (size_t)InfectionState::Infected)    = 1.0 / params.get<TimeInfected>();
+    }
+
     /**
     *@brief Computes the reproduction number at a given index time of the Model output obtained by the Simulation.
     *@param t_idx The index time at which the reproduction number is computed.
@@ -133,9 +150,7 @@ public:
             return mio::success(get_reproduction_number((size_t)0, y).value());
         }
 
-        auto times = std::vector<ScalarType>(y.get_times().begin(), y.get_times().end());
-
-        auto time_late = std::distance(times.begin(), std::lower_bound(times.begin(), times.end(), t_value));
+        auto time_late = y.lower_bound_time(t_value);
 
         ScalarType y1 = get_reproduction_number(static_cast<size_t>(time_late - 1), y).value();
         ScalarType y2 = get_reproduction_number(static_cast<size_t>(time_late), y).value();
@@ -36,30 +36,39 @@ namespace osir
     * define the model *
     ********************/
 
-class Model : public CompartmentalModel<InfectionState, Populations<InfectionState>, Parameters>
+/**
+ * @brief SIR model.
+ * @tparam FP Floating point type of the state, e.g. float for large ensembles.
+ */
+template <class FP = ScalarType>
+class Model : public CompartmentalModel<InfectionState, mio::Populations<InfectionState>, Parameters, FP>
 {
-    using Base = CompartmentalModel<InfectionState, mio::Populations<InfectionState>, Parameters>;
+    using Base = CompartmentalModel<InfectionState, mio::Populations<InfectionState>, Parameters, FP>;
 
 public:
+    using typename Base::Populations;
+    using typename Base::ParameterSet;
+
     Model()
         : Base(Populations({InfectionState::Count}, 0.), ParameterSet())
     {
     }
 
-    void get_derivatives(Eigen::Ref<const Eigen::VectorXd> pop, Eigen::Ref<const Eigen::VectorXd> y, double t,
-                         Eigen::Ref<Eigen::VectorXd> dydt) const override
+    void get_derivatives(Eigen::Ref<const Vector<FP>> pop, Eigen::Ref<const Vector<FP>> y, double t,
+                         Eigen::Ref<Vector<FP>> dydt) const override
     {
-        auto& params     = this->parameters;
-        double coeffStoI = params.get<ContactPatterns>().get_matrix_at(t)(0, 0) *
-                           params.get<TransmissionProbabilityOnContact>() / populations.get_total();
+        auto& params           = this->parameters;
+        const FP coeffStoI     = FP(params.template get<ContactPatterns>().get_matrix_at(t)(0, 0) *
+                                    params.template get<TransmissionProbabilityOnContact>() /
+                                    this->populations.get_total());
+        const FP rate_recovery = FP(1.0 / params.template get<TimeInfected>());
 
         dydt[(size_t)InfectionState::Susceptible] =
             -coeffStoI * y[(size_t)InfectionState::Susceptible] * pop[(size_t)InfectionState::Infected];
         dydt[(size_t)InfectionState::Infected] =
             coeffStoI * y[(size_t)InfectionState::Susceptible] * pop[(size_t)InfectionState::Infected] -
-            (1.0 / params.get<TimeInfected>()) * y[(size_t)InfectionState::Infected];
-        dydt[(size_t)InfectionState::Recovered] =
-            (1.0 / params.get<TimeInfected>()) * y[(size_t)InfectionState::Infected];
+            rate_recovery * y[(size_t)InfectionState::Infected];
+        dydt[(size_t)InfectionState::Recovered] = rate_recovery * y[(size_t)InfectionState::Infected];
     }
 };
 
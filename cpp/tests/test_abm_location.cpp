@@ -82,18 +82,22 @@ TEST(TestLocation, addRemovePerson)
     ASSERT_EQ(home.get_number_persons(), 0u);
     ASSERT_EQ(location.get_subpopulation(t, mio::abm::InfectionState::InfectedSymptoms), 2);
     ASSERT_EQ(location.get_subpopulation(t, mio::abm::InfectionState::Exposed), 1);
-    ASSERT_EQ(location.get_cells()[0].m_persons.size(), 3u);
-    ASSERT_EQ(location.get_cells()[1].m_persons.size(), 2u);
-    ASSERT_EQ(location.get_cells()[2].m_persons.size(), 0u);
+    ASSERT_EQ(location.get_cells()[0].m_num_persons, 3u);
+    ASSERT_EQ(location.get_cells()[1].m_num_persons, 2u);
+    ASSERT_EQ(location.get_cells()[2].m_num_persons, 0u);
+    ASSERT_EQ(location.get_number_persons(1), 2u);
+    ASSERT_EQ(location.get_subpopulation(t, mio::abm::InfectionState::InfectedSymptoms, 0), 2);
+    ASSERT_EQ(location.get_subpopulation(t, mio::abm::InfectionState::InfectedSymptoms, 1), 1);
+    ASSERT_EQ(location.get_subpopulation(t, mio::abm::InfectionState::Exposed, 2), 0);
 
     location.remove_person(person2);
 
     EXPECT_EQ(location.get_number_persons(), 2u);
     ASSERT_EQ(location.get_subpopulation(t, mio::abm::InfectionState::InfectedSymptoms), 1);
     ASSERT_EQ(location.get_subpopulation(t, mio::abm::InfectionState::Exposed), 1);
-    ASSERT_EQ(location.get_cells()[0].m_persons.size(), 2u);
-    ASSERT_EQ(location.get_cells()[1].m_persons.size(), 2u);
-    ASSERT_EQ(location.get_cells()[2].m_persons.size(), 0u);
+    ASSERT_EQ(location.get_cells()[0].m_num_persons, 2u);
+    ASSERT_EQ(location.get_cells()[1].m_num_persons, 2u);
+    ASSERT_EQ(location.get_cells()[2].m_num_persons, 0u);
 }
 
 TEST(TestLocation, CacheExposureRate)
@@ -277,6 +281,89 @@ TEST(TestLocation, interact)
     EXPECT_EQ(susceptible.get_infection_state(t + dt), mio::abm::InfectionState::Exposed);
 }
 
+TEST(TestLocation, interactMultipleCells)
+{
+    using testing::Return;
+
+    auto rng = mio::RandomNumberGenerator();
+    auto t   = mio::abm::TimePoint(0);
+    auto dt  = mio::abm::seconds(8640); //0.1 days
+
+    mio::abm::Parameters params = mio::abm::Parameters(num_age_groups);
+    params.set_default<mio::abm::ViralLoadDistributions>(num_age_groups);
+    params.get<mio::abm::ViralLoadDistributions>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] = {
+        {1., 1.}, {0.0001, 0.0001}, {-0.0001, -0.0001}};
+    params.set_default<mio::abm::InfectivityDistributions>(num_age_groups);
+    params.get<mio::abm::InfectivityDistributions>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] = {
+        {1., 1.}, {1., 1.}};
+
+    //setup location with one infected person in each of the first two cells
+    mio::abm::Location home(mio::abm::LocationType::Home, 0, num_age_groups);
+    mio::abm::Location location(mio::abm::LocationType::PublicTransport, 0, num_age_groups, 3);
+    auto infected1 = make_test_person(home, age_group_15_to_34, mio::abm::InfectionState::InfectedSymptoms, t, params);
+    auto infected2 = make_test_person(home, age_group_15_to_34, mio::abm::InfectionState::InfectedSymptoms, t, params);
+    infected1.migrate_to(location, {0});
+    infected2.migrate_to(location, {1});
+    location.cache_exposure_rates(t, dt, num_age_groups);
+    ASSERT_EQ(location.get_number_persons(0), 1u);
+    ASSERT_EQ(location.get_number_persons(1), 1u);
+
+    ScopedMockDistribution<testing::StrictMock<MockDistribution<mio::ExponentialDistribution<double>>>>
+        mock_exponential_dist;
+
+    //a person in multiple cells is exposed to all of them, but only draws once
+    auto susceptible = make_test_person(home, age_group_15_to_34, mio::abm::InfectionState::Susceptible, t, params);
+    susceptible.migrate_to(location, {0, 1, 2});
+    auto person_rng = mio::abm::Person::RandomNumberGenerator(rng, susceptible);
+    EXPECT_CALL(mock_exponential_dist.get_mock(), invoke).Times(1).WillOnce(Return(100.0));
+    location.interact(person_rng, susceptible, t, dt, params);
+    EXPECT_EQ(susceptible.get_infection_state(t + dt), mio::abm::InfectionState::Susceptible);
+    EXPECT_EQ(location.get_number_persons(2), 1u);
+}
+
+TEST(TestLocation, sampleInfector)
+{
+    auto t  = mio::abm::TimePoint(0);
+    auto dt = mio::abm::seconds(8640); //0.1 days
+
+    mio::abm::Parameters params = mio::abm::Parameters(num_age_groups);
+    params.set_default<mio::abm::ViralLoadDistributions>(num_age_groups);
+    params.get<mio::abm::ViralLoadDistributions>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] = {
+        {1., 1.}, {0.0001, 0.0001}, {-0.0001, -0.0001}};
+    params.set_default<mio::abm::InfectivityDistributions>(num_age_groups);
+    params.get<mio::abm::InfectivityDistributions>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] = {
+        {1., 1.}, {1., 1.}};
+
+    //setup location with one infected person in each of the first two cells
+    mio::abm::Location home(mio::abm::LocationType::Home, 0, num_age_groups);
+    mio::abm::Location location(mio::abm::LocationType::PublicTransport, 0, num_age_groups, 3);
+    auto infected1 = make_test_person(home, age_group_15_to_34, mio::abm::InfectionState::InfectedSymptoms, t, params);
+    auto infected2 = make_test_person(home, age_group_15_to_34, mio::abm::InfectionState::InfectedSymptoms, t, params);
+    auto susceptible = make_test_person(home, age_group_15_to_34, mio::abm::InfectionState::Susceptible, t, params);
+    infected1.migrate_to(location, {0});
+    infected2.migrate_to(location, {1});
+    location.cache_exposure_rates(t, dt, num_age_groups);
+    auto wildtype = mio::abm::VirusVariant::Wildtype;
+
+    //only persons in the same cell can be the infector
+    susceptible.migrate_to(location, {0});
+    EXPECT_EQ(location.sample_infector(0.0, susceptible, wildtype, t, dt, params).get(), &infected1);
+    EXPECT_EQ(location.sample_infector(0.99, susceptible, wildtype, t, dt, params).get(), &infected1);
+    EXPECT_EQ(location.sample_infector(0.5, susceptible, mio::abm::VirusVariant::Count, t, dt, params).get(),
+              nullptr);
+
+    //both infected persons contribute equally
+    susceptible.migrate_to(home);
+    susceptible.migrate_to(location, {0, 1});
+    EXPECT_EQ(location.sample_infector(0.49, susceptible, wildtype, t, dt, params).get(), &infected1);
+    EXPECT_EQ(location.sample_infector(0.51, susceptible, wildtype, t, dt, params).get(), &infected2);
+
+    //no infected person in the cell
+    susceptible.migrate_to(home);
+    susceptible.migrate_to(location, {2});
+    EXPECT_EQ(location.sample_infector(0.5, susceptible, wildtype, t, dt, params).get(), nullptr);
+}
+
 TEST(TestLocation, setCapacity)
 {
     mio::abm::Location location(mio::abm::LocationType::Home, 0, num_age_groups);
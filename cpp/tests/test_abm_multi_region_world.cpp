@@ -0,0 +1,126 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "abm/multi_region_world.h"
+#include "abm_helpers.h"
+#include "memilio/mobility/graph.h"
+#include "memilio/mobility/graph_simulation.h"
+
+namespace
+{
+//regions with one home each, the homes have the same LocationId in every region
+struct MultiRegionSetup {
+    mio::abm::MultiRegionWorld world;
+    std::vector<mio::abm::LocationId> homes;
+    mio::abm::Person* person;
+};
+
+MultiRegionSetup make_multi_region_world(uint32_t num_regions)
+{
+    MultiRegionSetup setup;
+    for (uint32_t r = 0; r < num_regions; ++r) {
+        auto world = mio::abm::World(num_age_groups);
+        world.use_migration_rules(false);
+        auto home = world.add_location(mio::abm::LocationType::Home);
+        if (r == 0) {
+            setup.person = &add_test_person(world, home);
+            setup.person->set_assigned_location(home);
+        }
+        setup.homes.push_back(home);
+        setup.world.add_region(std::move(world));
+    }
+    return setup;
+}
+
+void evolve(mio::abm::MultiRegionWorld& world, mio::abm::TimePoint t0, mio::abm::TimePoint tmax)
+{
+    for (auto t = t0; t < tmax; t += mio::abm::hours(1)) {
+        world.evolve(t, mio::abm::hours(1));
+    }
+}
+} // namespace
+
+TEST(TestMultiRegionWorld, crossRegionTrips)
+{
+    auto setup   = make_multi_region_world(2);
+    auto& world  = setup.world;
+    auto& person = *setup.person;
+    auto t0      = mio::abm::TimePoint(0);
+    world.add_trip(0, {1, mio::abm::Trip(person.get_person_id(), t0 + mio::abm::hours(8), setup.homes[1])});
+    world.add_trip(0, {0, mio::abm::Trip(person.get_person_id(), t0 + mio::abm::hours(17), setup.homes[0])});
+    EXPECT_EQ(world.get_num_trips(0), 2);
+    EXPECT_EQ(world.get_num_trips(1), 0);
+
+    auto& home     = world.get_region(0).get_individualized_location(setup.homes[0]);
+    auto& visiting = world.get_region(1).get_individualized_location(setup.homes[1]);
+
+    //the Locations have the same id, but are different Locations
+    //the Person stays in the other region until the next Trip
+    evolve(world, t0, t0 + mio::abm::hours(12));
+    EXPECT_EQ(&person.get_location(), &visiting);
+    EXPECT_EQ(visiting.get_number_persons(), 1);
+    EXPECT_EQ(home.get_number_persons(), 0);
+    EXPECT_EQ(world.get_subpopulation_combined(t0 + mio::abm::hours(12), mio::abm::InfectionState::Susceptible), 1);
+
+    evolve(world, t0 + mio::abm::hours(12), t0 + mio::abm::hours(18));
+    EXPECT_EQ(&person.get_location(), &home);
+    EXPECT_EQ(visiting.get_number_persons(), 0);
+    EXPECT_EQ(home.get_number_persons(), 1);
+
+    //trips are repeated the next day
+    evolve(world, t0 + mio::abm::hours(18), t0 + mio::abm::days(1) + mio::abm::hours(9));
+    EXPECT_EQ(&person.get_location(), &visiting);
+}
+
+TEST(TestMultiRegionWorld, onlyLastTripOfStep)
+{
+    auto setup   = make_multi_region_world(3);
+    auto& world  = setup.world;
+    auto& person = *setup.person;
+    auto t0      = mio::abm::TimePoint(0);
+    world.add_trip(0, {2, mio::abm::Trip(person.get_person_id(), t0 + mio::abm::minutes(30), setup.homes[2])});
+    world.add_trip(0, {1, mio::abm::Trip(person.get_person_id(), t0 + mio::abm::minutes(10), setup.homes[1])});
+
+    world.evolve(t0, mio::abm::hours(1));
+    EXPECT_EQ(&person.get_location(), &world.get_region(2).get_individualized_location(setup.homes[2]));
+    EXPECT_EQ(world.get_region(1).get_individualized_location(setup.homes[1]).get_number_persons(), 0);
+}
+
+TEST(TestMultiRegionWorld, graphNode)
+{
+    auto setup   = make_multi_region_world(2);
+    auto& person = *setup.person;
+    auto t0      = mio::abm::TimePoint(0);
+    setup.world.add_trip(0, {1, mio::abm::Trip(person.get_person_id(), t0 + mio::abm::hours(8), setup.homes[1])});
+    setup.world.add_trip(0, {0, mio::abm::Trip(person.get_person_id(), t0 + mio::abm::hours(17), setup.homes[0])});
+
+    mio::Graph<mio::abm::MultiRegionWorld, int> graph;
+    graph.add_node(0, std::move(setup.world));
+    graph.add_node(1);
+    graph.add_edge(0, 1, 0);
+    auto sim = mio::make_graph_sim(0.0, 0.5, std::move(graph), &mio::abm::evolve_model,
+                                   [](double, double, int&, mio::abm::MultiRegionWorld&, mio::abm::MultiRegionWorld&) {
+                                   });
+
+    auto& world = sim.get_graph().nodes()[0].property;
+    sim.advance(0.5);
+    EXPECT_EQ(&person.get_location(), &world.get_region(1).get_individualized_location(setup.homes[1]));
+    sim.advance(1.0);
+    EXPECT_EQ(&person.get_location(), &world.get_region(0).get_individualized_location(setup.homes[0]));
+}
@@ -0,0 +1,83 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "abm/transmission_tree.h"
+#include "abm_helpers.h"
+#include "temp_file_register.h"
+
+TEST(TestTransmissionTree, recordInfection)
+{
+    using testing::Return;
+
+    static_assert(mio::abm::has_infection_hook_v<mio::abm::TransmissionTreeRecorder>, "Callback not detected.");
+    static_assert(mio::abm::has_phase_end_hook_v<mio::abm::TransmissionTreeRecorder>, "Callback not detected.");
+
+    auto t     = mio::abm::TimePoint(0);
+    auto dt    = mio::abm::hours(1);
+    auto world = mio::abm::World(num_age_groups);
+    world.use_migration_rules(false);
+
+    //setup so p1 doesn't transition
+    world.parameters.get<mio::abm::IncubationPeriod>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] =
+        2 * dt.days();
+    world.parameters
+        .get<mio::abm::InfectedNoSymptomsToSymptoms>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] =
+        2 * dt.days();
+    world.parameters
+        .get<mio::abm::InfectedNoSymptomsToRecovered>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] =
+        2 * dt.days();
+
+    auto home_id = world.add_location(mio::abm::LocationType::Home);
+    auto& p1 = add_test_person(world, home_id, age_group_15_to_34, mio::abm::InfectionState::InfectedNoSymptoms);
+    auto& p2 = add_test_person(world, home_id, age_group_15_to_34, mio::abm::InfectionState::Susceptible);
+    p1.set_assigned_location(home_id);
+    p2.set_assigned_location(home_id);
+
+    //setup mock so p2 becomes infected
+    ScopedMockDistribution<testing::StrictMock<MockDistribution<mio::ExponentialDistribution<double>>>>
+        mock_exponential_dist;
+    EXPECT_CALL(mock_exponential_dist.get_mock(), invoke).Times(1).WillOnce(Return(0.0));
+
+    mio::abm::TransmissionTreeRecorder recorder(world.parameters);
+    world.evolve(t, dt, recorder);
+
+    ASSERT_EQ(p2.get_infection_state(t + dt), mio::abm::InfectionState::Exposed);
+    auto expected_event = mio::abm::TransmissionEvent{p2.get_person_id(),
+                                                      p1.get_person_id(),
+                                                      home_id.index,
+                                                      uint32_t(mio::abm::LocationType::Home),
+                                                      uint32_t(mio::abm::VirusVariant::Wildtype),
+                                                      (t + dt / 2).seconds()};
+    auto events         = recorder.get_events();
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_EQ(events[0], expected_event);
+
+    //flushing appends to the file and clears the recorder
+    TempFileRegister file_register;
+    auto path = file_register.get_unique_path("TestTransmissionTree-%%%%-%%%%.bin");
+    ASSERT_THAT(recorder.flush(path), IsSuccess());
+    EXPECT_EQ(recorder.get_events().size(), 0);
+    ASSERT_THAT(recorder.flush(path), IsSuccess());
+    auto read_events = mio::abm::read_transmission_tree(path);
+    ASSERT_THAT(read_events, IsSuccess());
+    ASSERT_EQ(read_events.value().size(), 1);
+    EXPECT_EQ(read_events.value()[0], expected_event);
+
+    EXPECT_THAT(mio::abm::read_transmission_tree(path + ".missing"), IsFailure(mio::StatusCode::FileNotFound));
+}
@@ -643,18 +643,14 @@ TEST(TestWorld, copyWorld)
     ASSERT_EQ(copied_world.get_locations()[2].get_cells().size(), world.get_locations()[2].get_cells().size());
     ASSERT_EQ(copied_world.get_locations()[3].get_cells().size(), world.get_locations()[2].get_cells().size());
     ASSERT_EQ(copied_world.get_locations()[4].get_cells().size(), world.get_locations()[2].get_cells().size());
-    ASSERT_EQ(copied_world.get_locations()[1].get_cells()[0].m_persons.size(),
-              world.get_locations()[1].get_cells()[0].m_persons.size());
-    ASSERT_EQ(copied_world.get_locations()[2].get_cells()[0].m_persons.size(),
-              world.get_locations()[2].get_cells()[0].m_persons.size());
-    ASSERT_EQ(copied_world.get_locations()[3].get_cells()[0].m_persons.size(),
-              world.get_locations()[3].get_cells()[0].m_persons.size());
-    ASSERT_EQ(copied_world.get_locations()[4].get_cells()[0].m_persons.size(),
-              world.get_locations()[4].get_cells()[0].m_persons.size());
-    ASSERT_EQ(copied_world.get_locations()[1].get_cells()[0].m_persons[0],
-              world.get_locations()[1].get_cells()[0].m_persons[0]);
-    ASSERT_EQ(copied_world.get_locations()[2].get_cells()[0].m_persons[0],
-              world.get_locations()[2].get_cells()[0].m_persons[0]);
+    ASSERT_EQ(copied_world.get_locations()[1].get_cells()[0].m_num_persons,
+              world.get_locations()[1].get_cells()[0].m_num_persons);
+    ASSERT_EQ(copied_world.get_locations()[2].get_cells()[0].m_num_persons,
+              world.get_locations()[2].get_cells()[0].m_num_persons);
+    ASSERT_EQ(copied_world.get_locations()[3].get_cells()[0].m_num_persons,
+              world.get_locations()[3].get_cells()[0].m_num_persons);
+    ASSERT_EQ(copied_world.get_locations()[4].get_cells()[0].m_num_persons,
+              world.get_locations()[4].get_cells()[0].m_num_persons);
 
     ASSERT_EQ(copied_world.get_persons().size(), world.get_persons().size());
     ASSERT_EQ(copied_world.get_persons()[0].get_location().get_index(),
@@ -690,10 +686,6 @@ TEST(TestWorld, copyWorld)
     ASSERT_NE(&copied_world.get_locations()[4].get_cells(), &world.get_locations()[4].get_cells());
     ASSERT_NE(&(copied_world.get_locations()[1].get_cells()[0]), &(world.get_locations()[1].get_cells()[0]));
     ASSERT_NE(&(copied_world.get_locations()[2].get_cells()[0]), &(world.get_locations()[2].get_cells()[0]));
-    ASSERT_NE(&(copied_world.get_locations()[1].get_cells()[0].m_persons[0]),
-              &(world.get_locations()[1].get_cells()[0].m_persons[0]));
-    ASSERT_NE(&(copied_world.get_locations()[2].get_cells()[0].m_persons[0]),
-              &(world.get_locations()[2].get_cells()[0].m_persons[0]));
 
     ASSERT_NE(&copied_world.get_persons()[0], &world.get_persons()[0]);
     ASSERT_NE(&copied_world.get_persons()[1], &world.get_persons()[1]);
@@ -719,3 +711,72 @@ TEST(TestWorld, copyWorld)
     ASSERT_NE(copied_world.get_persons()[1].get_location().get_type(),
               world.get_persons()[1].get_location().get_type());
 }
+
+namespace
+{
+struct CountingHooks {
+    void on_infection(mio::abm::Person::RandomNumberGenerator&, const mio::abm::Person& person,
+                      const mio::abm::Location&, mio::abm::TimePoint, mio::abm::TimeSpan)
+    {
+        infected.push_back(person.get_person_id());
+    }
+    void on_migration(const mio::abm::Person& person, const mio::abm::Location& origin,
+                      const mio::abm::Location& destination, mio::abm::TimePoint)
+    {
+        migrations.push_back({person.get_person_id(), origin.get_type(), destination.get_type()});
+    }
+    std::vector<uint32_t> infected;
+    std::vector<std::tuple<uint32_t, mio::abm::LocationType, mio::abm::LocationType>> migrations;
+};
+} // namespace
+
+TEST(TestWorld, evolveWithHooks)
+{
+    using testing::Return;
+
+    static_assert(!mio::abm::has_infection_hook_v<mio::abm::NoHooks>, "NoHooks must not define callbacks.");
+    static_assert(!mio::abm::has_test_hook_v<mio::abm::NoHooks>, "NoHooks must not define callbacks.");
+    static_assert(!mio::abm::has_migration_hook_v<mio::abm::NoHooks>, "NoHooks must not define callbacks.");
+    static_assert(mio::abm::has_infection_hook_v<CountingHooks>, "Callback not detected.");
+    static_assert(!mio::abm::has_test_hook_v<CountingHooks>, "Callback detected but not defined.");
+    static_assert(mio::abm::has_migration_hook_v<CountingHooks>, "Callback not detected.");
+
+    auto t     = mio::abm::TimePoint(0);
+    auto dt    = mio::abm::hours(1);
+    auto world = mio::abm::World(num_age_groups);
+    world.use_migration_rules(false);
+
+    //setup so p1 doesn't transition
+    world.parameters.get<mio::abm::IncubationPeriod>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] =
+        2 * dt.days();
+    world.parameters
+        .get<mio::abm::InfectedNoSymptomsToSymptoms>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] =
+        2 * dt.days();
+    world.parameters
+        .get<mio::abm::InfectedNoSymptomsToRecovered>()[{mio::abm::VirusVariant::Wildtype, age_group_15_to_34}] =
+        2 * dt.days();
+
+    auto home_id = world.add_location(mio::abm::LocationType::Home);
+    auto work_id = world.add_location(mio::abm::LocationType::Work);
+    auto& p1 = add_test_person(world, home_id, age_group_15_to_34, mio::abm::InfectionState::InfectedNoSymptoms);
+    auto& p2 = add_test_person(world, home_id, age_group_15_to_34, mio::abm::InfectionState::Susceptible);
+    p1.set_assigned_location(home_id);
+    p2.set_assigned_location(home_id);
+    p2.set_assigned_location(work_id);
+    world.get_trip_list().add_trip(mio::abm::Trip(p2.get_person_id(), t + dt / 2, work_id, home_id));
+
+    //setup mock so p2 becomes infected
+    ScopedMockDistribution<testing::StrictMock<MockDistribution<mio::ExponentialDistribution<double>>>>
+        mock_exponential_dist;
+    EXPECT_CALL(mock_exponential_dist.get_mock(), invoke).Times(1).WillOnce(Return(0.0));
+
+    CountingHooks hooks;
+    world.evolve(t, dt, hooks);
+
+    EXPECT_EQ(p2.get_infection_state(t + dt), mio::abm::InfectionState::Exposed);
+    ASSERT_EQ(hooks.infected.size(), 1);
+    EXPECT_EQ(hooks.infected[0], p2.get_person_id());
+    ASSERT_EQ(hooks.migrations.size(), 1);
+    EXPECT_EQ(hooks.migrations[0], std::make_tuple(p2.get_person_id(), mio::abm::LocationType::Home,
+                                                   mio::abm::LocationType::Work));
+}
@@ -0,0 +1,204 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/math/adapt_rk.h"
+#include "memilio/math/dormand_prince.h"
+#include "memilio/math/euler.h"
+#include "memilio/math/rosenbrock.h"
+#include "ode_secir/model.h"
+#include "ode_secirvvs/model.h"
+#include "ode_seir/model.h"
+#include "ode_sir/model.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+
+namespace
+{
+std::atomic<bool> g_count_allocations{false};
+std::atomic<size_t> g_num_allocations{0};
+
+void count_allocation()
+{
+    if (g_count_allocations.load(std::memory_order_relaxed)) {
+        g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Count the heap allocations during a function call.
+ */
+template <class F>
+size_t count_allocations(F&& f)
+{
+    g_num_allocations   = 0;
+    g_count_allocations = true;
+    f();
+    g_count_allocations = false;
+    return g_num_allocations;
+}
+} // namespace
+
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+#define MIO_TEST_ALLOCATION_HOOK 1
+
+// Replace the allocation functions of the C library in the whole test executable to count heap allocations.
+// Both operator new and Eigen use these functions.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+
+void* malloc(size_t size) noexcept
+{
+    count_allocation();
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) noexcept
+{
+    count_allocation();
+    return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept
+{
+    count_allocation();
+    return __libc_realloc(ptr, size);
+}
+}
+#endif
+
+class TestAllocations : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+#ifndef MIO_TEST_ALLOCATION_HOOK
+        GTEST_SKIP() << "Counting heap allocations is only supported with glibc.";
+#endif
+    }
+};
+
+namespace
+{
+/**
+ * Check that the right hand side of a model does not allocate after the first evaluation.
+ */
+template <class Model>
+void expect_allocation_free_rhs(const Model& model)
+{
+    const Eigen::VectorXd y = model.get_initial_values();
+    Eigen::VectorXd dydt(y.size());
+    model.eval_right_hand_side(y, y, 0.5, dydt); // first evaluation may fill buffers and caches
+    EXPECT_EQ(count_allocations([&] {
+                  model.eval_right_hand_side(y, y, 0.5, dydt);
+              }),
+              0);
+    if constexpr (mio::is_flow_model<Model>::value) {
+        Eigen::VectorXd flows = model.get_initial_flows();
+        EXPECT_EQ(count_allocations([&] {
+                      flows.setZero();
+                      model.get_flows(y, y, 0.5, flows);
+                      model.get_derivatives(flows, dydt);
+                  }),
+                  0);
+    }
+}
+
+mio::osecir::Model make_secir_model(int num_groups)
+{
+    mio::osecir::Model model(num_groups);
+    for (auto i = mio::AgeGroup(0); i < mio::AgeGroup(num_groups); ++i) {
+        model.populations[{i, mio::osecir::InfectionState::Exposed}]            = 10;
+        model.populations[{i, mio::osecir::InfectionState::InfectedNoSymptoms}] = 10;
+        model.populations[{i, mio::osecir::InfectionState::InfectedSymptoms}]   = 10;
+        model.populations[{i, mio::osecir::InfectionState::InfectedCritical}]   = 1;
+        model.populations.set_difference_from_group_total<mio::AgeGroup>({i, mio::osecir::InfectionState::Susceptible},
+                                                                         1000);
+    }
+    model.parameters.get<mio::osecir::ContactPatterns>().get_cont_freq_mat()[0].get_baseline().setConstant(1.0);
+    return model;
+}
+} // namespace
+
+TEST_F(TestAllocations, seir)
+{
+    mio::oseir::Model model;
+    model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Infected)}]    = 10;
+    model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Susceptible)}] = 1000;
+    expect_allocation_free_rhs(model);
+}
+
+TEST_F(TestAllocations, sir)
+{
+    mio::osir::Model<double> model;
+    model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Infected)}]    = 10;
+    model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Susceptible)}] = 1000;
+    expect_allocation_free_rhs(model);
+}
+
+TEST_F(TestAllocations, secir)
+{
+    expect_allocation_free_rhs(make_secir_model(3));
+}
+
+TEST_F(TestAllocations, secirvvs)
+{
+    mio::osecirvvs::Model model(3);
+    for (auto i = mio::AgeGroup(0); i < mio::AgeGroup(3); ++i) {
+        model.populations[{i, mio::osecirvvs::InfectionState::ExposedNaive}]                = 10;
+        model.populations[{i, mio::osecirvvs::InfectionState::InfectedSymptomsNaive}]       = 10;
+        model.populations[{i, mio::osecirvvs::InfectionState::SusceptibleNaive}]            = 1000;
+        model.populations[{i, mio::osecirvvs::InfectionState::SusceptibleImprovedImmunity}] = 100;
+    }
+    model.parameters.get<mio::osecirvvs::ContactPatterns>().get_cont_freq_mat()[0].get_baseline().setConstant(1.0);
+    expect_allocation_free_rhs(model);
+}
+
+template <class Core>
+class TestAllocationsIntegratorStep : public TestAllocations
+{
+};
+
+//the ControlledStepperWrapper is not tested, the error checker of boost's odeint creates temporaries in the
+//vector space algebra for Eigen vectors
+using IntegratorCores = ::testing::Types<mio::EulerIntegratorCore, mio::RKIntegratorCore,
+                                         mio::DormandPrinceIntegratorCore, mio::RosenbrockIntegratorCore>;
+TYPED_TEST_SUITE(TestAllocationsIntegratorStep, IntegratorCores);
+
+TYPED_TEST(TestAllocationsIntegratorStep, step)
+{
+    auto model           = make_secir_model(3);
+    mio::DerivFunction f = [&model](Eigen::Ref<const Eigen::VectorXd> x, double s, Eigen::Ref<Eigen::VectorXd> dxds) {
+        model.eval_right_hand_side(x, x, s, dxds);
+    };
+    TypeParam core;
+    Eigen::VectorXd yt = model.get_initial_values();
+    Eigen::VectorXd ytp1(yt.size());
+    double t = 0.0, dt = 0.1;
+    core.step(f, yt, t, dt, ytp1); // first step may allocate the workspace of the core
+    yt = ytp1;
+    EXPECT_EQ(count_allocations([&] {
+                  core.step(f, yt, t, dt, ytp1);
+              }),
+              0);
+}
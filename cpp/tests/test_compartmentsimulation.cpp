@@ -19,9 +19,14 @@
 */
 
 #include "memilio/compartments/simulation.h"
+#include "memilio/data/analyze_result.h"
+#include "memilio/math/euler.h"
+#include "matchers.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
+#include <algorithm>
+
 TEST(TestCompartmentSimulation, integrator_uses_model_reference)
 {
     struct MockModel {
@@ -48,3 +53,80 @@ TEST(TestCompartmentSimulation, integrator_uses_model_reference)
 
     ASSERT_NEAR(sim.get_result().get_last_value()[0], 3.0, 1e-5);
 }
+
+TEST(TestCompartmentSimulation, static_integrator)
+{
+    struct MockModel {
+        Eigen::VectorXd get_initial_values() const
+        {
+            return Eigen::VectorXd::Ones(1);
+        }
+        void eval_right_hand_side(const Eigen::Ref<const Eigen::VectorXd>& pop,
+                                  const Eigen::Ref<const Eigen::VectorXd>&, double,
+                                  Eigen::Ref<Eigen::VectorXd> dydt) const
+        {
+            dydt[0] = -pop[0];
+        }
+    };
+
+    auto sim_static  = mio::Simulation<MockModel, mio::EulerIntegratorCore>(MockModel(), 0.0, 0.5);
+    auto sim_dynamic = mio::Simulation<MockModel>(MockModel(), 0.0, 0.5);
+    sim_dynamic.set_integrator(std::make_shared<mio::EulerIntegratorCore>());
+    sim_static.advance(2.0);
+    sim_dynamic.advance(2.0);
+
+    ASSERT_EQ(sim_static.get_result().get_num_time_points(), 5);
+    EXPECT_EQ(sim_static.get_result().get_last_value()[0], std::pow(0.5, 4));
+    EXPECT_EQ(sim_static.get_result().get_last_value(), sim_dynamic.get_result().get_last_value());
+}
+
+TEST(TestCompartmentSimulation, output_policy)
+{
+    struct MockModel {
+        Eigen::VectorXd get_initial_values() const
+        {
+            return Eigen::VectorXd::Ones(2);
+        }
+        void eval_right_hand_side(const Eigen::Ref<const Eigen::VectorXd>& pop,
+                                  const Eigen::Ref<const Eigen::VectorXd>&, double,
+                                  Eigen::Ref<Eigen::VectorXd> dydt) const
+        {
+            dydt[0] = -pop[0];
+            dydt[1] = pop[0];
+        }
+    };
+
+    auto sim_all  = mio::Simulation<MockModel>(MockModel(), 0.0, 0.1);
+    auto sim_last = mio::Simulation<MockModel>(MockModel(), 0.0, 0.1);
+    auto sim_grid = mio::Simulation<MockModel>(MockModel(), 0.0, 0.1);
+    sim_last.set_output_policy(mio::OutputPolicy::LastStep);
+    sim_grid.set_output_policy(mio::OutputPolicy::Grid, 0.25);
+    EXPECT_EQ(sim_all.get_output_policy(), mio::OutputPolicy::AllSteps);
+    for (auto t : {1.3, 2.0}) {
+        sim_all.advance(t);
+        sim_last.advance(t);
+        sim_grid.advance(t);
+    }
+    auto& result_all  = sim_all.get_result();
+    auto& result_last = sim_last.get_result();
+    auto& result_grid = sim_grid.get_result();
+
+    //the integration is the same, only the stored time points differ
+    auto idx_stop = std::find(result_all.get_times().begin(), result_all.get_times().end(), 1.3) -
+                    result_all.get_times().begin();
+    ASSERT_LT(idx_stop, result_all.get_num_time_points());
+    ASSERT_EQ(result_last.get_num_time_points(), 3);
+    EXPECT_EQ(result_last.get_time(1), 1.3);
+    EXPECT_EQ(print_wrap(result_last[1]), print_wrap(result_all[idx_stop]));
+    EXPECT_EQ(result_last.get_last_time(), 2.0);
+    EXPECT_EQ(print_wrap(result_last.get_last_value()), print_wrap(result_all.get_last_value()));
+
+    //the time point at 1.3 is not on the grid and was replaced by the second call of advance
+    std::vector<double> grid = {0.0, 0.25, 0.5, 0.75, 1.0, 1.25, 1.5, 1.75, 2.0};
+    auto interpolated        = mio::interpolate_simulation_result(result_all, grid);
+    ASSERT_EQ(result_grid.get_num_time_points(), 9);
+    for (Eigen::Index i = 0; i < 9; ++i) {
+        EXPECT_NEAR(result_grid.get_time(i), grid[i], 1e-12);
+        EXPECT_THAT(print_wrap(result_grid[i]), MatrixNear(print_wrap(interpolated[i]), 1e-12, 1e-12));
+    }
+}
@@ -75,3 +75,84 @@ TEST(TestContactMatrixGroup, sum)
     EXPECT_THAT(print_wrap(cmg.get_matrix_at(0.0)), MatrixNear(Eigen::MatrixXd::Constant(3, 3, 6.0)));
     EXPECT_THAT(print_wrap(cmg.get_matrix_at(1.0)), MatrixNear(Eigen::MatrixXd::Constant(3, 3, 3.0)));
 }
+
+TEST(TestContactMatrixGroup, sumIntoBuffer)
+{
+    mio::ContactMatrixGroup cmg(3, 2);
+    cmg[0] = mio::ContactMatrix(Eigen::MatrixXd::Constant(3, 3, 1.0));
+    cmg[1] = mio::ContactMatrix(Eigen::MatrixXd::Constant(3, 3, 2.0));
+    cmg[2] = mio::ContactMatrix(Eigen::MatrixXd::Constant(3, 3, 3.0));
+    cmg.add_damping(0.5, mio::DampingLevel(3), mio::DampingType(1), mio::SimulationTime(1.0));
+
+    //buffer is resized and overwritten
+    Eigen::MatrixXd buffer = Eigen::MatrixXd::Constant(1, 2, 7.0);
+    cmg.get_matrix_at(0.0, buffer);
+    EXPECT_THAT(print_wrap(buffer), MatrixNear(Eigen::MatrixXd::Constant(3, 3, 6.0)));
+    cmg.get_matrix_at(1.0, buffer);
+    EXPECT_THAT(print_wrap(buffer), MatrixNear(Eigen::MatrixXd(cmg.get_matrix_at(1.0))));
+    EXPECT_THAT(print_wrap(buffer), MatrixNear(Eigen::MatrixXd::Constant(3, 3, 3.0)));
+}
+
+TEST(TestContactMatrixGroup, cachedEvaluation)
+{
+    mio::ContactMatrixGroup cmg(2, 2);
+    cmg[0] = mio::ContactMatrix(Eigen::MatrixXd::Constant(2, 2, 1.0));
+    cmg[1] = mio::ContactMatrix(Eigen::MatrixXd::Constant(2, 2, 2.0));
+    cmg.add_damping(0.5, mio::DampingLevel(3), mio::DampingType(1), mio::SimulationTime(2.0));
+    cmg.set_cache_capacity(2);
+
+    Eigen::MatrixXd buffer;
+    for (auto t : {0.0, 0.5, 1.0, 1.5, 2.0, 3.0, 0.5}) {
+        cmg.get_matrix_at(t, buffer);
+        EXPECT_EQ(print_wrap(buffer), print_wrap(Eigen::MatrixXd(cmg.get_matrix_at(t)))) << "t = " << t;
+    }
+    //intervals before and after the damping
+    EXPECT_EQ(cmg.get_cache().get_num_entries(), 2);
+
+    //cache is cleared when the dampings change
+    cmg.add_damping(0.5, mio::DampingLevel(3), mio::DampingType(1), mio::SimulationTime(-1.0));
+    EXPECT_EQ(cmg.get_cache().get_num_entries(), 0);
+    cmg.get_matrix_at(0.5, buffer);
+    EXPECT_THAT(print_wrap(buffer), MatrixNear(Eigen::MatrixXd::Constant(2, 2, 1.5)));
+
+    //cache is cleared when a matrix is changed
+    cmg[1].get_baseline().setConstant(4.0);
+    cmg.get_matrix_at(0.5, buffer);
+    EXPECT_THAT(print_wrap(buffer), MatrixNear(Eigen::MatrixXd::Constant(2, 2, 2.5)));
+
+    //disabled cache
+    cmg.set_cache_capacity(0);
+    cmg.get_matrix_at(0.5, buffer);
+    EXPECT_EQ(cmg.get_cache().get_num_entries(), 0);
+    EXPECT_THAT(print_wrap(buffer), MatrixNear(Eigen::MatrixXd::Constant(2, 2, 2.5)));
+}
+
+TEST(TestContactMatrixGroup, shareCache)
+{
+    mio::ContactMatrixGroup cmg1(1, 2);
+    cmg1[0] = mio::ContactMatrix(Eigen::MatrixXd::Constant(2, 2, 1.0));
+    cmg1.add_damping(0.5, mio::DampingLevel(3), mio::DampingType(1), mio::SimulationTime(2.0));
+    auto cmg2 = cmg1;
+    auto cmg3 = cmg1;
+    cmg3.add_damping(0.5, mio::DampingLevel(3), mio::DampingType(1), mio::SimulationTime(5.0));
+
+    //copies don't share the cache unless requested
+    Eigen::MatrixXd buffer;
+    cmg1.get_matrix_at(0.0, buffer);
+    EXPECT_EQ(cmg2.get_cache().get_num_entries(), 0);
+    EXPECT_TRUE(cmg2.share_cache(cmg1));
+    EXPECT_FALSE(cmg3.share_cache(cmg1));
+    EXPECT_EQ(&cmg2.get_cache(), &cmg1.get_cache());
+    EXPECT_NE(&cmg3.get_cache(), &cmg1.get_cache());
+    cmg2.get_matrix_at(3.0, buffer);
+    EXPECT_EQ(cmg1.get_cache().get_num_entries(), 2);
+
+    //changed group stops sharing
+    cmg2.add_damping(0.5, mio::DampingLevel(4), mio::DampingType(1), mio::SimulationTime(1.0));
+    EXPECT_NE(&cmg2.get_cache(), &cmg1.get_cache());
+    EXPECT_EQ(cmg1.get_cache().get_num_entries(), 2);
+    cmg2.get_matrix_at(3.0, buffer);
+    EXPECT_THAT(print_wrap(buffer), MatrixNear(Eigen::MatrixXd::Constant(2, 2, 0.25)));
+    cmg1.get_matrix_at(3.0, buffer);
+    EXPECT_THAT(print_wrap(buffer), MatrixNear(Eigen::MatrixXd::Constant(2, 2, 0.5)));
+}
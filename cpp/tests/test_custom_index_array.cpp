@@ -18,6 +18,7 @@
 * limitations under the License.
 */
 #include "memilio/utils/custom_index_array.h"
+#include "memilio/utils/static_index_array.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 
@@ -380,3 +381,41 @@ TEST(CustomIndexArray, resize_one_dimension)
     ASSERT_EQ(array.size().indices, std::make_tuple(Tag0{3}, Tag1{2}));
     ASSERT_EQ(array.numel(), 6);
 }
+
+TEST(StaticIndexArray, sizesAndIndexing)
+{
+    enum class Dim4
+    {
+        A,
+        B,
+        C,
+        Count
+    };
+
+    using ArrayType = mio::StaticIndexArray<double, Dim2, Dim4>;
+    static_assert(ArrayType::numel() == 6, "wrong number of elements");
+    ASSERT_EQ(ArrayType::size<Dim2>(), mio::Index<Dim2>(2));
+    ASSERT_EQ(ArrayType::size<Dim4>(), mio::Index<Dim4>(3));
+
+    ArrayType array({Dim2::Count, Dim4::Count}, 1.0);
+    ASSERT_EQ(array.array().size(), 6);
+    EXPECT_TRUE((array.array() == 1.0).all());
+
+    //same flat index as CustomIndexArray
+    mio::CustomIndexArray<double, Dim2, Dim4> dynamic_array({Dim2::Count, Dim4::Count});
+    for (auto i = mio::Index<Dim2>(0); i < array.size<Dim2>(); ++i) {
+        for (auto j = mio::Index<Dim4>(0); j < array.size<Dim4>(); ++j) {
+            EXPECT_EQ(array.get_flat_index({i, j}), dynamic_array.get_flat_index({i, j}));
+        }
+    }
+
+    array[{Dim2::Female, Dim4::B}] = 3.0;
+    EXPECT_EQ(array.array()[4], 3.0);
+    EXPECT_EQ(std::accumulate(array.begin(), array.end(), 0.0), 8.0);
+
+    auto copy = array;
+    EXPECT_EQ(copy, array);
+    copy = 0.0;
+    EXPECT_NE(copy, array);
+    EXPECT_EQ((copy[{Dim2::Female, Dim4::B}]), 0.0);
+}
@@ -130,3 +130,33 @@ TEST(TestDampings, automatic_cache_update)
 
     EXPECT_THAT(print_wrap(dampings.get_matrix_at(2.0)), MatrixNear((Eigen::VectorXd(2) << 0.25, 0.25).finished()));
 }
+
+TEST(TestDampings, constantInterval)
+{
+    mio::Dampings<mio::Damping<mio::ColumnVectorShape>> dampings(2);
+    dampings.add(0.25, mio::DampingLevel(1), mio::DampingType(2), mio::SimulationTime(2.0));
+    dampings.add(0.5, mio::DampingLevel(1), mio::DampingType(2), mio::SimulationTime(5.0));
+
+    EXPECT_EQ(dampings.get_constant_interval(0.0), std::make_pair(std::numeric_limits<double>::lowest(), 1.0));
+    EXPECT_EQ(dampings.get_constant_interval(1.5), std::make_pair(1.5, 1.5));
+    EXPECT_EQ(dampings.get_constant_interval(2.0), std::make_pair(2.0, 4.0));
+    EXPECT_EQ(dampings.get_constant_interval(3.0), std::make_pair(2.0, 4.0));
+    EXPECT_EQ(dampings.get_constant_interval(10.0), std::make_pair(5.0, std::numeric_limits<double>::max()));
+
+    //matrix is equal everywhere in the interval
+    EXPECT_EQ(print_wrap(dampings.get_matrix_at(2.0)), print_wrap(dampings.get_matrix_at(4.0)));
+}
+
+TEST(TestDampings, removeAndClear)
+{
+    mio::Dampings<mio::Damping<mio::ColumnVectorShape>> dampings(2);
+    dampings.add(0.25, mio::DampingLevel(1), mio::DampingType(2), mio::SimulationTime(1.0));
+    dampings.add(0.5, mio::DampingLevel(2), mio::DampingType(2), mio::SimulationTime(1.0));
+    EXPECT_THAT(print_wrap(dampings.get_matrix_at(2.0)), MatrixNear((Eigen::VectorXd(2) << 0.625, 0.625).finished()));
+
+    dampings.remove(1);
+    EXPECT_THAT(print_wrap(dampings.get_matrix_at(2.0)), MatrixNear((Eigen::VectorXd(2) << 0.25, 0.25).finished()));
+
+    dampings.clear();
+    EXPECT_THAT(print_wrap(dampings.get_matrix_at(2.0)), MatrixNear(Eigen::VectorXd::Zero(2)));
+}
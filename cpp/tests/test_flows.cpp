@@ -27,6 +27,7 @@
 #include "memilio/utils/type_list.h"
 #include "memilio/compartments/simulation.h"
 #include "memilio/compartments/flow_simulation.h"
+#include "memilio/data/analyze_result.h"
 #include "gtest/gtest.h"
 #include "matchers.h"
 
@@ -68,6 +69,26 @@ public:
     }
 };
 
+//flows proportional to the source compartment, for states of any floating point type
+template <class FP>
+class LinearFlowModel : public mio::FlowModel<I, mio::Populations<I>, mio::oseir::Parameters, Flows, FP>
+{
+    using Base = mio::FlowModel<I, mio::Populations<I>, mio::oseir::Parameters, Flows, FP>;
+
+public:
+    LinearFlowModel()
+        : Base(typename Base::Populations({I::Count}, 0.), mio::oseir::Parameters{})
+    {
+    }
+    void get_flows(Eigen::Ref<const mio::Vector<FP>> /*pop*/, Eigen::Ref<const mio::Vector<FP>> y, double /*t*/,
+                   Eigen::Ref<mio::Vector<FP>> flows) const override
+    {
+        flows[this->template get_flat_flow_index<I::Susceptible, I::Exposed>()] = FP(0.3) * y[(size_t)I::Susceptible];
+        flows[this->template get_flat_flow_index<I::Exposed, I::Infected>()]    = FP(0.2) * y[(size_t)I::Exposed];
+        flows[this->template get_flat_flow_index<I::Infected, I::Recovered>()]  = FP(0.1) * y[(size_t)I::Infected];
+    }
+};
+
 TEST(TestFlows, FlowChart)
 {
     EXPECT_EQ(Flows().size(), 3);
@@ -201,3 +222,115 @@ TEST(TestFlows, GetFlowIndex)
     auto idx4 = m.get_flat_flow_index<I::Susceptible, I::Exposed>({CatA(10), CatB(4), CatC(6)});
     EXPECT_EQ(idx4, 10 * (5 * 7 * 3) + 4 * (7 * 3) + 6 * (3));
 }
+
+TEST(TestFlows, GetDerivatives)
+{
+    TestModel m({I::Count, CatA(2), CatB(3), CatC(1)});
+
+    auto check_derivatives = [&m]() {
+        const auto dims = m.populations.size();
+        Eigen::VectorXd flows(m.get_initial_flows().size());
+        for (Eigen::Index i = 0; i < flows.size(); ++i) {
+            flows[i] = i + 1.0;
+        }
+        Eigen::VectorXd expected = Eigen::VectorXd::Zero(m.populations.numel());
+        for (auto a : mio::make_index_range(mio::get<CatA>(dims))) {
+            for (auto b : mio::make_index_range(mio::get<CatB>(dims))) {
+                for (auto c : mio::make_index_range(mio::get<CatC>(dims))) {
+                    auto se = flows[m.get_flat_flow_index<I::Susceptible, I::Exposed>({a, b, c})];
+                    auto ei = flows[m.get_flat_flow_index<I::Exposed, I::Infected>({a, b, c})];
+                    auto ir = flows[m.get_flat_flow_index<I::Infected, I::Recovered>({a, b, c})];
+                    expected[m.populations.get_flat_index({I::Susceptible, a, b, c})] -= se;
+                    expected[m.populations.get_flat_index({I::Exposed, a, b, c})] += se - ei;
+                    expected[m.populations.get_flat_index({I::Infected, a, b, c})] += ei - ir;
+                    expected[m.populations.get_flat_index({I::Recovered, a, b, c})] += ir;
+                }
+            }
+        }
+        Eigen::VectorXd dydt = Eigen::VectorXd::Constant(m.populations.numel(), 1.0);
+        m.get_derivatives(flows, dydt);
+        EXPECT_THAT(print_wrap(dydt), MatrixNear(expected));
+    };
+
+    check_derivatives();
+
+    // the model must notice the new dimensions
+    m.populations = TestModel::Populations({I::Count, CatA(3), CatB(1), CatC(2)}, 0.);
+    check_derivatives();
+}
+
+TEST(TestFlows, Stoichiometry)
+{
+    TestModel m({I::Count, CatA(2), CatB(3), CatC(2)});
+    const auto& stoichiometry = m.get_stoichiometry();
+    ASSERT_EQ(stoichiometry.rows(), m.populations.numel());
+    ASSERT_EQ(stoichiometry.cols(), m.get_initial_flows().size());
+    EXPECT_EQ(stoichiometry.nonZeros(), 2 * stoichiometry.cols());
+
+    // same as get_derivatives for each time point of a TimeSeries
+    mio::TimeSeries<double> flows(stoichiometry.cols());
+    for (int i = 0; i < 3; ++i) {
+        flows.add_time_point(i, Eigen::VectorXd::Random(stoichiometry.cols()));
+    }
+    Eigen::MatrixXd populations = stoichiometry * flows.matrix().bottomRows(flows.get_num_elements());
+    Eigen::VectorXd dydt(m.populations.numel());
+    for (int i = 0; i < 3; ++i) {
+        m.get_derivatives(flows.get_value(i), dydt);
+        EXPECT_THAT(print_wrap(populations.col(i)), MatrixNear(dydt));
+    }
+}
+
+TEST(TestFlows, FlowSimulationFloat)
+{
+    LinearFlowModel<double> model_double;
+    LinearFlowModel<float> model_float;
+    for (auto i : mio::make_index_range(model_double.populations.size())) {
+        model_double.populations[i] = 1000. * (1 + size_t(i));
+        model_float.populations[i]  = 1000. * (1 + size_t(i));
+    }
+
+    // same integration scheme for both, in double and in single precision
+    auto results_double = mio::simulate_flows(0., 10., 0.1, model_double, std::make_shared<mio::RKIntegratorCore>());
+    auto results_float  = mio::simulate_flows(0., 10., 0.1, model_float);
+    static_assert(std::is_same<decltype(results_float), std::vector<mio::TimeSeries<float>>>::value,
+                  "The results must use the floating point type of the model.");
+
+    EXPECT_NEAR(results_float[0].get_last_time(), 10., 1e-5);
+    // the total population is conserved up to the accuracy of float
+    EXPECT_NEAR(results_float[0].get_last_value().sum(), 10000.f, 1e-2);
+    for (Eigen::Index i = 0; i < 4; ++i) {
+        EXPECT_NEAR(results_float[0].get_last_value()[i], results_double[0].get_last_value()[i], 1e-1);
+    }
+    for (Eigen::Index i = 0; i < 3; ++i) {
+        EXPECT_NEAR(results_float[1].get_last_value()[i], results_double[1].get_last_value()[i], 1e-1);
+    }
+}
+
+TEST(TestFlows, FlowSimulationOutputGrid)
+{
+    LinearFlowModel<double> model;
+    for (auto i : mio::make_index_range(model.populations.size())) {
+        model.populations[i] = 1000. * (1 + size_t(i));
+    }
+
+    mio::FlowSimulation<LinearFlowModel<double>> sim_all(model, 0.0, 0.1);
+    mio::FlowSimulation<LinearFlowModel<double>> sim_grid(model, 0.0, 0.1);
+    sim_grid.set_output_policy(mio::OutputPolicy::Grid, 1.0);
+    for (auto t : {2.5, 5.0}) {
+        sim_all.advance(t);
+        sim_grid.advance(t);
+    }
+
+    //the results at the grid points are interpolated from the integration steps
+    std::vector<double> grid = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0};
+    auto pop_interpolated    = mio::interpolate_simulation_result(sim_all.get_result(), grid);
+    auto flows_interpolated  = mio::interpolate_simulation_result(sim_all.get_flows(), grid);
+    ASSERT_EQ(sim_grid.get_result().get_num_time_points(), 6);
+    ASSERT_EQ(sim_grid.get_flows().get_num_time_points(), 6);
+    for (Eigen::Index i = 0; i < 6; ++i) {
+        EXPECT_NEAR(sim_grid.get_result().get_time(i), grid[i], 1e-12);
+        EXPECT_NEAR(sim_grid.get_flows().get_time(i), grid[i], 1e-12);
+        EXPECT_THAT(print_wrap(sim_grid.get_result()[i]), MatrixNear(print_wrap(pop_interpolated[i]), 1e-10, 1e-10));
+        EXPECT_THAT(print_wrap(sim_grid.get_flows()[i]), MatrixNear(print_wrap(flows_interpolated[i]), 1e-10, 1e-10));
+    }
+}
@@ -19,6 +19,8 @@
 */
 #include "memilio/math/euler.h"
 #include "memilio/math/adapt_rk.h"
+#include "memilio/math/dormand_prince.h"
+#include "memilio/math/rosenbrock.h"
 #include "memilio/math/stepper_wrapper.h"
 #include <actions.h>
 
@@ -29,6 +31,8 @@
 #include <fstream>
 #include <ios>
 #include <cmath>
+#include <algorithm>
+#include <type_traits>
 
 void sin_deriv(Eigen::Ref<Eigen::VectorXd const> /*y*/, const double t, Eigen::Ref<Eigen::VectorXd> dydt)
 {
@@ -90,7 +94,8 @@ TEST_F(TestVerifyNumericalIntegratorEuler, euler_sine)
 }
 
 using TestTypes = ::testing::Types<
-    mio::RKIntegratorCore, mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_cash_karp54>,
+    mio::RKIntegratorCore, mio::DormandPrinceIntegratorCore, mio::RosenbrockIntegratorCore,
+    mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_cash_karp54>,
     // mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_dopri5>, // TODO: reenable once boost bug is fixed
     mio::ControlledStepperWrapper<boost::numeric::odeint::runge_kutta_fehlberg78>>;
 
@@ -136,7 +141,34 @@ TYPED_TEST(TestVerifyNumericalIntegrator, sine)
 
     this->err = std::sqrt(this->err) / this->n;
 
-    EXPECT_NEAR(this->err, 0.0, 1e-7);
+    // the global error of the Rosenbrock method of 2nd order is larger than the local tolerances
+    const double max_err = std::is_same<TypeParam, mio::RosenbrockIntegratorCore>::value ? 1e-6 : 1e-7;
+    EXPECT_NEAR(this->err, 0.0, max_err);
+}
+
+TYPED_TEST(TestVerifyNumericalIntegrator, staticIntegrator)
+{
+    // same steps with and without virtual calls and std::function
+    auto core = std::make_shared<TypeParam>();
+    core->set_abs_tolerance(1e-7);
+    core->set_rel_tolerance(1e-7);
+    auto f = [](auto&& x, auto&& t, auto&& dxdt) {
+        dxdt[0] = std::cos(t);
+        dxdt[1] = -x[1];
+    };
+
+    double dt_dynamic = 0.1, dt_static = 0.1;
+    mio::TimeSeries<double> result_dynamic(0.0, Eigen::VectorXd::Ones(2));
+    mio::TimeSeries<double> result_static(0.0, Eigen::VectorXd::Ones(2));
+    mio::OdeIntegrator(core).advance(f, 2.0, dt_dynamic, result_dynamic);
+    mio::StaticOdeIntegrator<TypeParam>(core).advance(f, 2.0, dt_static, result_static);
+
+    ASSERT_EQ(result_static.get_num_time_points(), result_dynamic.get_num_time_points());
+    for (Eigen::Index i = 0; i < result_static.get_num_time_points(); ++i) {
+        EXPECT_EQ(result_static.get_time(i), result_dynamic.get_time(i));
+        EXPECT_EQ(result_static[i], result_dynamic[i]);
+    }
+    EXPECT_EQ(dt_static, dt_dynamic);
 }
 
 TYPED_TEST(TestVerifyNumericalIntegrator, adaptiveStepSizing)
@@ -154,6 +186,12 @@ TYPED_TEST(TestVerifyNumericalIntegrator, adaptiveStepSizing)
     integrator.set_rel_tolerance(tol);
     integrator.set_dt_min(dt_min);
     integrator.set_dt_max(dt_max);
+    if constexpr (std::is_same<TypeParam, mio::RosenbrockIntegratorCore>::value) {
+        // the implicit method is stable for deriv_fail below, a zero jacobian makes it explicit
+        integrator.set_jacobian([](auto&&, auto&&, auto&& jac) {
+            jac.setZero();
+        });
+    }
 
     double t_eval;
     bool step_okay;
@@ -264,6 +302,72 @@ TEST(TestOdeIntegrator, integratorStopsAtTMax)
     EXPECT_DOUBLE_EQ(result.get_last_time(), 2.34);
 }
 
+TEST(TestOdeIntegrator, denseOutput)
+{
+    // integrators with dense output step past tmax and interpolate instead of shortening the last step
+    double t_eval_max = 0.0;
+    auto f            = [&t_eval_max](auto&&, auto&& t, auto&& dxdt) {
+        t_eval_max = std::max(t_eval_max, double(t));
+        dxdt[0]    = std::cos(t);
+    };
+    auto core = std::make_shared<mio::DormandPrinceIntegratorCore>(1e-8, 1e-8, 1e-10, 0.1);
+    ASSERT_TRUE(core->has_dense_output());
+    mio::TimeSeries<double> result(0.0, Eigen::VectorXd::Zero(1));
+    double dt       = 0.1;
+    auto integrator = mio::OdeIntegrator(core);
+
+    integrator.advance(f, 0.45, dt, result);
+    ASSERT_EQ(result.get_num_time_points(), 6);
+    EXPECT_DOUBLE_EQ(result.get_time(4), 0.4);
+    EXPECT_EQ(result.get_last_time(), 0.45);
+    EXPECT_NEAR(result.get_last_value()[0], std::sin(0.45), 1e-8);
+    EXPECT_NEAR(t_eval_max, 0.5, 1e-10); // the last step is not shortened
+    EXPECT_DOUBLE_EQ(dt, 0.1);
+
+    // continues at the interpolated state
+    integrator.advance(f, 1.0, dt, result);
+    EXPECT_EQ(result.get_last_time(), 1.0);
+    EXPECT_NEAR(result.get_last_value()[0], std::sin(1.0), 1e-8);
+}
+
+TEST(TestOdeIntegrator, stiff)
+{
+    // y_0 quickly follows cos(t), y_1 = sin(t)
+    const double k = 1e4;
+    auto f         = [k](auto&& x, auto&& t, auto&& dxdt) {
+        dxdt[0] = -k * (x[0] - std::cos(t));
+        dxdt[1] = std::cos(t);
+    };
+    auto jacobian = [k](auto&&, auto&&, auto&& jac) {
+        jac.setZero();
+        jac(0, 0) = -k;
+    };
+    const double y0_exact = (k * k * std::cos(1.0) + k * std::sin(1.0)) / (k * k + 1);
+
+    auto integrate = [&f](std::shared_ptr<mio::IntegratorCore> core) {
+        mio::TimeSeries<double> result(0.0, Eigen::VectorXd::Zero(2));
+        double dt = 0.1;
+        mio::OdeIntegrator(core).advance(f, 1.0, dt, result);
+        return result;
+    };
+
+    auto result_explicit = integrate(std::make_shared<mio::RKIntegratorCore>(1e-6, 1e-4, 1e-10, 1.0));
+    auto rosenbrock      = std::make_shared<mio::RosenbrockIntegratorCore>(1e-6, 1e-4);
+    auto result_implicit = integrate(rosenbrock);
+    rosenbrock->set_jacobian(jacobian);
+    auto result_jacobian = integrate(rosenbrock);
+
+    // the explicit integrator is limited by stability, the implicit only by accuracy
+    EXPECT_GT(result_explicit.get_num_time_points(), 1000);
+    EXPECT_LT(result_implicit.get_num_time_points(), 200);
+    EXPECT_NEAR(result_implicit.get_last_value()[0], y0_exact, 1e-4);
+    EXPECT_NEAR(result_implicit.get_last_value()[1], std::sin(1.0), 1e-4);
+
+    // finite differences are exact for this linear system
+    ASSERT_EQ(result_jacobian.get_num_time_points(), result_implicit.get_num_time_points());
+    EXPECT_NEAR(result_jacobian.get_last_value()[0], result_implicit.get_last_value()[0], 1e-8);
+}
+
 auto DoStepAndIncreaseStepsize(double new_dt)
 {
     return testing::DoAll(testing::WithArgs<2, 3>(AddAssign()), testing::WithArgs<4, 1>(AssignUnsafe()),
@@ -25,6 +25,8 @@
 #include "ode_seir/parameters.h"
 #include "memilio/math/euler.h"
 #include "memilio/compartments/simulation.h"
+#include "memilio/compartments/batch_simulation.h"
+#include "matchers.h"
 #include <gtest/gtest.h>
 #include <iomanip>
 #include <vector>
@@ -325,3 +327,76 @@ TEST(TestOdeSeir, get_reproduction_number)
     EXPECT_NEAR(model.get_reproduction_number(0.2, result).value(), 1.8614409729718137676, 1e-12);
     EXPECT_NEAR(model.get_reproduction_number(0.9, result).value(), 1.858670429549998504, 1e-12);
 }
+
+TEST(TestOdeSeir, batchSimulation)
+{
+    std::vector<mio::oseir::Model> models(3);
+    for (size_t i = 0; i < models.size(); ++i) {
+        auto& model = models[i];
+        model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Exposed)}]     = 100;
+        model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Infected)}]    = 100;
+        model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Susceptible)}] = 10000;
+        model.parameters.set<mio::oseir::TransmissionProbabilityOnContact>(0.5 + 0.2 * i);
+        model.parameters.get<mio::oseir::ContactPatterns>().get_baseline()(0, 0) = 2.7;
+    }
+
+    // shared step size, same result as separate simulations up to the tolerances
+    mio::BatchSimulation<mio::oseir::Model> shared(models, 0.0, 0.1);
+    shared.advance(10.0);
+    shared.advance(20.0);
+    for (size_t i = 0; i < models.size(); ++i) {
+        auto expected = mio::simulate(0.0, 20.0, 0.1, models[i]);
+        auto& result  = shared.get_result(i);
+        EXPECT_EQ(result.get_num_time_points(), shared.get_result(0).get_num_time_points());
+        EXPECT_NEAR(result.get_last_time(), 20.0, 1e-10);
+        for (Eigen::Index j = 0; j < result.get_num_elements(); ++j) {
+            EXPECT_NEAR(result.get_last_value()[j], expected.get_last_value()[j],
+                        1e-3 * std::abs(expected.get_last_value()[j]) + 1e-6);
+        }
+    }
+
+    // step size per member, same steps as separate simulations
+    auto results = mio::simulate_batch(0.0, 20.0, 0.1, models, mio::BatchStepSizeControl::PerMember);
+    ASSERT_EQ(results.size(), models.size());
+    for (size_t i = 0; i < models.size(); ++i) {
+        auto expected = mio::simulate(0.0, 20.0, 0.1, models[i]);
+        ASSERT_EQ(results[i].get_num_time_points(), expected.get_num_time_points());
+        EXPECT_EQ(print_wrap(results[i].get_last_value()), print_wrap(expected.get_last_value()));
+    }
+}
+
+TEST(TestOdeSeir, jacobian)
+{
+    using SeirFlowModel = mio::FlowModel<mio::oseir::InfectionState, mio::Populations<mio::oseir::InfectionState>,
+                                         mio::oseir::Parameters, mio::oseir::Flows>;
+    mio::oseir::Model model;
+    model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Exposed)}]     = 100;
+    model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Infected)}]    = 100;
+    model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Recovered)}]   = 100;
+    model.populations[{mio::Index<mio::oseir::InfectionState>(mio::oseir::InfectionState::Susceptible)}] = 10000;
+    model.parameters.get<mio::oseir::ContactPatterns>().get_baseline()(0, 0) = 2.7;
+    const Eigen::VectorXd y = model.get_initial_values();
+    const auto num_flows    = model.get_initial_flows().size();
+
+    // analytic jacobian of the flows matches the finite differences of the default implementation
+    Eigen::MatrixXd flow_jac(num_flows, y.size()), flow_jac_fd(num_flows, y.size());
+    model.get_flow_jacobian(y, 0.5, flow_jac);
+    model.SeirFlowModel::get_flow_jacobian(y, 0.5, flow_jac_fd);
+    for (Eigen::Index i = 0; i < flow_jac.size(); ++i) {
+        EXPECT_NEAR(flow_jac.data()[i], flow_jac_fd.data()[i], 1e-6 * std::abs(flow_jac.data()[i]) + 1e-9);
+    }
+
+    // jacobian of the derivatives matches finite differences of the right hand side
+    Eigen::MatrixXd jac(y.size(), y.size());
+    model.get_jacobian(y, 0.5, jac);
+    Eigen::VectorXd dydt(y.size()), dydt_perturbed(y.size());
+    model.eval_right_hand_side(y, y, 0.5, dydt);
+    for (Eigen::Index j = 0; j < y.size(); ++j) {
+        Eigen::VectorXd y_perturbed = y;
+        y_perturbed[j] += 1e-3;
+        model.eval_right_hand_side(y_perturbed, y_perturbed, 0.5, dydt_perturbed);
+        for (Eigen::Index i = 0; i < y.size(); ++i) {
+            EXPECT_NEAR(jac(i, j), (dydt_perturbed[i] - dydt[i]) / 1e-3, 1e-6);
+        }
+    }
+}
@@ -23,6 +23,7 @@
 #include "ode_sir/model.h"
 #include "ode_sir/infection_state.h"
 #include "ode_sir/parameters.h"
+#include "memilio/math/adapt_rk.h"
 #include "memilio/math/euler.h"
 #include "memilio/compartments/simulation.h"
 #include <gtest/gtest.h>
@@ -35,7 +36,7 @@ TEST(TestOdeSir, simulateDefault)
     double tmax = 1;
     double dt   = 0.1;
 
-    mio::osir::Model model;
+    mio::osir::Model<double> model;
     mio::TimeSeries<double> result = simulate(t0, tmax, dt, model);
 
     EXPECT_NEAR(result.get_last_time(), tmax, 1e-10);
@@ -50,7 +51,7 @@ TEST(TestOdeSir, compareWithPreviousRun)
 
     double total_population = 1061000;
 
-    mio::osir::Model model;
+    mio::osir::Model<double> model;
 
     model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Infected)}]  = 1000;
     model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Recovered)}] = 1000;
@@ -66,7 +67,7 @@ TEST(TestOdeSir, compareWithPreviousRun)
 
     std::vector<std::vector<double>> refData = load_test_data_csv<double>("ode-sir-compare.csv");
     auto integrator                          = std::make_shared<mio::EulerIntegratorCore>();
-    auto result                              = mio::simulate<mio::osir::Model>(t0, tmax, dt, model, integrator);
+    auto result                              = mio::simulate<mio::osir::Model<double>>(t0, tmax, dt, model, integrator);
 
     ASSERT_EQ(refData.size(), static_cast<size_t>(result.get_num_time_points()));
 
@@ -105,7 +106,7 @@ TEST(TestOdeSir, checkPopulationConservation)
 
     double total_population = 1061000;
 
-    mio::osir::Model model;
+    mio::osir::Model<double> model;
 
     model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Infected)}]  = 1000;
     model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Recovered)}] = 1000;
@@ -118,7 +119,7 @@ TEST(TestOdeSir, checkPopulationConservation)
 
     model.parameters.get<mio::osir::ContactPatterns>().get_baseline()(0, 0) = 2.7;
     model.parameters.get<mio::osir::ContactPatterns>().add_damping(0.6, mio::SimulationTime(12.5));
-    auto result        = mio::simulate<mio::osir::Model>(t0, tmax, dt, model);
+    auto result        = mio::simulate<mio::osir::Model<double>>(t0, tmax, dt, model);
     double num_persons = 0.0;
     for (auto i = 0; i < result.get_last_value().size(); i++) {
         num_persons += result.get_last_value()[i];
@@ -126,9 +127,39 @@ TEST(TestOdeSir, checkPopulationConservation)
     EXPECT_NEAR(num_persons, total_population, 1e-8);
 }
 
+TEST(TestOdeSir, simulateFloat)
+{
+    double total_population = 1061000;
+    auto init_model         = [&](auto& model) {
+        model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Infected)}]  = 1000;
+        model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Recovered)}] = 1000;
+        model.populations[{mio::Index<mio::osir::InfectionState>(mio::osir::InfectionState::Susceptible)}] =
+            total_population - 2000;
+        model.parameters.template set<mio::osir::TransmissionProbabilityOnContact>(1.0);
+        model.parameters.template set<mio::osir::TimeInfected>(2);
+        model.parameters.template get<mio::osir::ContactPatterns>().get_baseline()(0, 0) = 2.7;
+    };
+    mio::osir::Model<double> model_double;
+    mio::osir::Model<float> model_float;
+    init_model(model_double);
+    init_model(model_float);
+
+    // same integration scheme for both, in double and in single precision
+    auto result_double = mio::simulate(0., 10., 0.1, model_double, std::make_shared<mio::RKIntegratorCore>());
+    auto result_float  = mio::simulate(0., 10., 0.1, model_float);
+    static_assert(std::is_same<decltype(result_float), mio::TimeSeries<float>>::value,
+                  "The result must use the floating point type of the model.");
+
+    EXPECT_NEAR(result_float.get_last_time(), 10., 1e-5);
+    // relative accuracy of float
+    for (Eigen::Index i = 0; i < result_float.get_num_elements(); ++i) {
+        EXPECT_NEAR(result_float.get_last_value()[i], result_double.get_last_value()[i], 1e-5 * total_population);
+    }
+}
+
 TEST(TestOdeSir, check_constraints_parameters)
 {
-    mio::osir::Model model;
+    mio::osir::Model<double> model;
     model.parameters.set<mio::osir::TimeInfected>(6);
     model.parameters.set<mio::osir::TransmissionProbabilityOnContact>(0.04);
     model.parameters.get<mio::osir::ContactPatterns>().get_baseline()(0, 0) = 10;
@@ -151,7 +182,7 @@ TEST(TestOdeSir, check_constraints_parameters)
 TEST(TestOdeSir, apply_constraints_parameters)
 {
     const double tol_times = 1e-1;
-    mio::osir::Model model;
+    mio::osir::Model<double> model;
     model.parameters.set<mio::osir::TimeInfected>(6);
     model.parameters.set<mio::osir::TransmissionProbabilityOnContact>(0.04);
     model.parameters.get<mio::osir::ContactPatterns>().get_baseline()(0, 0) = 10;
@@ -20,6 +20,8 @@
 #include "memilio/utils/logging.h"
 #include "memilio/utils/parameter_set.h"
 #include "memilio/utils/custom_index_array.h"
+#include "memilio/utils/flat_parameter_set.h"
+#include "matchers.h"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
@@ -307,3 +309,55 @@ TEST(TestParameterSet, equality)
     ASSERT_TRUE(a != c);
     ASSERT_TRUE(a != d);
 }
+
+TEST(TestParameterSet, flatten)
+{
+    struct AgeGroup {
+    };
+
+    struct UncertainArrayParam {
+        using Type = mio::CustomIndexArray<mio::UncertainValue, AgeGroup>;
+        static Type get_default(mio::Index<AgeGroup> n_agegroups)
+        {
+            return Type({n_agegroups}, 0.5);
+        }
+    };
+
+    struct UncertainParam {
+        using Type = mio::UncertainValue;
+        static Type get_default(mio::Index<AgeGroup>)
+        {
+            return Type(2.0);
+        }
+    };
+
+    struct IntParam {
+        using Type = int;
+        static Type get_default(mio::Index<AgeGroup>)
+        {
+            return 1;
+        }
+    };
+
+    auto params = mio::ParameterSet<IntParam, UncertainArrayParam, UncertainParam>(mio::Index<AgeGroup>(3));
+    params.get<UncertainArrayParam>()[mio::Index<AgeGroup>(1)] = 1.5;
+    params.get<UncertainParam>().set_distribution(mio::ParameterDistributionUniform(1.0, 3.0));
+
+    //integers are not stored
+    EXPECT_EQ(mio::get_flat_size(params), 4);
+    EXPECT_EQ(mio::get_flat_offset<UncertainArrayParam>(params), 0);
+    EXPECT_EQ(mio::get_flat_offset<UncertainParam>(params), 3);
+
+    auto flat = mio::flatten(params);
+    EXPECT_THAT(print_wrap(flat), MatrixNear(print_wrap((Eigen::VectorXd(4) << 0.5, 1.5, 0.5, 2.0).finished())));
+
+    flat[mio::get_flat_offset<UncertainParam>(params)] = 2.5;
+    flat[0]                                            = -1.0;
+    mio::unflatten(flat, params);
+    EXPECT_EQ(params.get<UncertainArrayParam>()[mio::Index<AgeGroup>(0)], -1.0);
+    EXPECT_EQ(params.get<UncertainArrayParam>()[mio::Index<AgeGroup>(1)], 1.5);
+    EXPECT_EQ(params.get<UncertainParam>(), 2.5);
+    EXPECT_EQ(params.get<IntParam>(), 1);
+    //distributions are kept
+    ASSERT_NE(params.get<UncertainParam>().get_distribution(), nullptr);
+}
@@ -0,0 +1,115 @@
+/*
+* Copyright (C) 2020-2024 MEmilio
+*
+* Authors: Daniel Abele
+*
+* Contact: Martin J. Kuehn <Martin.Kuehn@DLR.de>
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+*     http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+#include "memilio/utils/ring_time_series.h"
+#include "matchers.h"
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+TEST(TestRingTimeSeries, createEmpty)
+{
+    mio::RingTimeSeries<double> ts(3, 4);
+    EXPECT_EQ(ts.get_num_elements(), 3);
+    EXPECT_EQ(ts.get_num_time_points(), 0);
+    EXPECT_EQ(ts.get_capacity(), 4);
+}
+
+TEST(TestRingTimeSeries, queue)
+{
+    mio::RingTimeSeries<double> ts(2, 4);
+    for (int i = 0; i < 3; ++i) {
+        ts.add_time_point(i, Eigen::VectorXd::Constant(2, i));
+    }
+
+    //the oldest time point is removed while new ones are added, the capacity stays the same
+    for (int i = 3; i < 20; ++i) {
+        ts.remove_first_time_point();
+        ts.add_time_point(i, Eigen::VectorXd::Constant(2, i));
+        ASSERT_EQ(ts.get_num_time_points(), 3);
+        ASSERT_EQ(ts.get_capacity(), 4);
+        for (Eigen::Index j = 0; j < 3; ++j) {
+            ASSERT_EQ(ts.get_time(j), i - 2 + j);
+            ASSERT_EQ(print_wrap(ts[j]), print_wrap(Eigen::VectorXd::Constant(2, i - 2 + j)));
+        }
+    }
+    EXPECT_EQ(ts.get_last_time(), 19);
+    EXPECT_EQ(print_wrap(ts.get_last_value()), print_wrap(Eigen::VectorXd::Constant(2, 19)));
+}
+
+TEST(TestRingTimeSeries, addFirst)
+{
+    mio::RingTimeSeries<double> ts(1);
+    ts.add_time_point(1.0, Eigen::VectorXd::Constant(1, 1.0));
+    ts.add_first_time_point(0.0, Eigen::VectorXd::Constant(1, 0.0));
+    ts.add_time_point(2.0, Eigen::VectorXd::Constant(1, 2.0));
+    ts.add_first_time_point(-1.0, Eigen::VectorXd::Constant(1, -1.0));
+    ASSERT_EQ(ts.get_num_time_points(), 4);
+    for (Eigen::Index i = 0; i < 4; ++i) {
+        EXPECT_EQ(ts.get_time(i), i - 1.0);
+        EXPECT_EQ(ts[i][0], i - 1.0);
+    }
+
+    ts.remove_last_time_point();
+    ts.remove_first_time_point();
+    ASSERT_EQ(ts.get_num_time_points(), 2);
+    EXPECT_EQ(ts.get_time(0), 0.0);
+    EXPECT_EQ(ts.get_last_time(), 1.0);
+}
+
+TEST(TestRingTimeSeries, growWrapped)
+{
+    mio::RingTimeSeries<double> ts(1, 4);
+    for (int i = 0; i < 4; ++i) {
+        ts.add_time_point(i, Eigen::VectorXd::Constant(1, i));
+    }
+    ts.remove_first_time_point();
+    ts.remove_first_time_point();
+    for (int i = 4; i < 9; ++i) {
+        ts.add_time_point(i, Eigen::VectorXd::Constant(1, i));
+    }
+    ASSERT_EQ(ts.get_num_time_points(), 7);
+    EXPECT_EQ(ts.get_capacity(), 8);
+    for (Eigen::Index i = 0; i < 7; ++i) {
+        EXPECT_EQ(ts.get_time(i), i + 2.0);
+        EXPECT_EQ(ts[i][0], i + 2.0);
+    }
+}
+
+TEST(TestRingTimeSeries, removeTimePoint)
+{
+    mio::RingTimeSeries<double> ts(1, 8);
+    for (int i = 0; i < 6; ++i) {
+        ts.add_time_point(i, Eigen::VectorXd::Constant(1, i));
+    }
+    ts.remove_time_point(1);
+    ts.remove_time_point(3);
+    ASSERT_EQ(ts.get_num_time_points(), 4);
+    auto expected = std::vector<double>{0.0, 2.0, 3.0, 5.0};
+    for (Eigen::Index i = 0; i < 4; ++i) {
+        EXPECT_EQ(ts.get_time(i), expected[i]);
+        EXPECT_EQ(ts[i][0], expected[i]);
+    }
+
+    auto linear = ts.to_time_series();
+    ASSERT_EQ(linear.get_num_time_points(), 4);
+    for (Eigen::Index i = 0; i < 4; ++i) {
+        EXPECT_EQ(linear.get_time(i), expected[i]);
+        EXPECT_EQ(linear[i][0], expected[i]);
+    }
+}
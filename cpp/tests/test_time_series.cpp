@@ -190,6 +190,37 @@ TYPED_TEST(TestTimeSeries, data)
                                                  TypeParam(2.0), TypeParam(2.5), TypeParam(3.0), TypeParam(3.5)));
 }
 
+TYPED_TEST(TestTimeSeries, valuesByTime)
+{
+    mio::TimeSeries<TypeParam> ts(3);
+    ts.add_time_point(TypeParam(0.0), mio::TimeSeries<TypeParam>::Vector::LinSpaced(3, TypeParam(1), TypeParam(3)));
+    ts.add_time_point(TypeParam(1.0), mio::TimeSeries<TypeParam>::Vector::LinSpaced(3, TypeParam(4), TypeParam(6)));
+
+    auto values = ts.values_by_time();
+    ASSERT_EQ(values.rows(), 2);
+    ASSERT_EQ(values.cols(), 3);
+    for (Eigen::Index i = 0; i < 2; ++i) {
+        for (Eigen::Index j = 0; j < 3; ++j) {
+            EXPECT_EQ(values(i, j), ts[i][j]);
+        }
+    }
+
+    //view writes to the storage
+    ts.values_by_time().col(1).setConstant(TypeParam(-1.0));
+    EXPECT_EQ(ts[0][1], TypeParam(-1.0));
+    EXPECT_EQ(ts[1][1], TypeParam(-1.0));
+    EXPECT_EQ(ts.get_time(1), TypeParam(1.0));
+
+    //contiguous trajectories
+    auto trajectories = ts.trajectories();
+    ASSERT_EQ(trajectories.rows(), 2);
+    ASSERT_EQ(trajectories.cols(), 3);
+    EXPECT_EQ(trajectories.data()[0], TypeParam(1.0));
+    EXPECT_EQ(trajectories.data()[1], TypeParam(4.0));
+    EXPECT_EQ(trajectories.data()[4], TypeParam(3.0));
+    EXPECT_EQ(trajectories.data()[5], TypeParam(6.0));
+}
+
 TYPED_TEST(TestTimeSeries, iteratorsRange)
 {
     mio::TimeSeries<TypeParam> ts(1);
@@ -323,6 +354,64 @@ TYPED_TEST(TestTimeSeries, create)
     }
 }
 
+TYPED_TEST(TestTimeSeries, lowerBoundTime)
+{
+    using Vec = typename mio::TimeSeries<TypeParam>::Vector;
+    mio::TimeSeries<TypeParam> ts(1);
+    for (auto t : {0.0, 0.5, 1.5, 2.0}) {
+        ts.add_time_point(TypeParam(t), Vec::Constant(1, TypeParam(t)));
+    }
+    EXPECT_EQ(ts.lower_bound_time(TypeParam(-1.0)), 0);
+    EXPECT_EQ(ts.lower_bound_time(TypeParam(0.0)), 0);
+    EXPECT_EQ(ts.lower_bound_time(TypeParam(0.25)), 1);
+    EXPECT_EQ(ts.lower_bound_time(TypeParam(1.5)), 2);
+    EXPECT_EQ(ts.lower_bound_time(TypeParam(2.0)), 3);
+    EXPECT_EQ(ts.lower_bound_time(TypeParam(3.0)), 4);
+}
+
+TYPED_TEST(TestTimeSeries, findTime)
+{
+    using Vec = typename mio::TimeSeries<TypeParam>::Vector;
+    mio::TimeSeries<TypeParam> ts(1);
+    for (auto t : {0.0, 0.5, 1.5, 2.0}) {
+        ts.add_time_point(TypeParam(t), Vec::Constant(1, TypeParam(t)));
+    }
+    EXPECT_EQ(ts.find_time(TypeParam(0.0)), 0);
+    EXPECT_EQ(ts.find_time(TypeParam(1.5)), 2);
+    EXPECT_EQ(ts.find_time(TypeParam(2.0)), 3);
+    EXPECT_EQ(ts.find_time(TypeParam(1.0)), 4);
+    EXPECT_EQ(ts.find_time(TypeParam(1.5 + 1e-3)), 4);
+    EXPECT_EQ(ts.find_time(TypeParam(1.5 + 1e-3), TypeParam(1e-2)), 2);
+    EXPECT_EQ(ts.find_time(TypeParam(1.5 - 1e-3), TypeParam(1e-2)), 2);
+    EXPECT_EQ(ts.find_time(TypeParam(-1e-3), TypeParam(1e-2)), 0);
+
+    auto it = mio::find_value_reverse(ts, TypeParam(0.5));
+    ASSERT_NE(it, ts.rend());
+    EXPECT_EQ((*it)[0], TypeParam(0.5));
+    EXPECT_EQ(mio::find_value_reverse(ts, TypeParam(0.75)), ts.rend());
+}
+
+TYPED_TEST(TestTimeSeries, interpolate)
+{
+    using Vec = typename mio::TimeSeries<TypeParam>::Vector;
+    mio::TimeSeries<TypeParam> ts(2);
+    ts.add_time_point(TypeParam(0.0), Vec::Constant(2, TypeParam(1.0)));
+    ts.add_time_point(TypeParam(1.0), Vec::Constant(2, TypeParam(3.0)));
+    ts.add_time_point(TypeParam(3.0), Vec::Constant(2, TypeParam(-1.0)));
+
+    Vec value(2);
+    ts.interpolate(TypeParam(-1.0), value);
+    EXPECT_THAT(print_wrap(value), MatrixNear(print_wrap(Vec::Constant(2, TypeParam(1.0)))));
+    ts.interpolate(TypeParam(0.5), value);
+    EXPECT_THAT(print_wrap(value), MatrixNear(print_wrap(Vec::Constant(2, TypeParam(2.0)))));
+    ts.interpolate(TypeParam(1.0), value);
+    EXPECT_THAT(print_wrap(value), MatrixNear(print_wrap(Vec::Constant(2, TypeParam(3.0)))));
+    ts.interpolate(TypeParam(2.5), value);
+    EXPECT_THAT(print_wrap(value), MatrixNear(print_wrap(Vec::Constant(2, TypeParam(0.0)))));
+    ts.interpolate(TypeParam(4.0), value);
+    EXPECT_THAT(print_wrap(value), MatrixNear(print_wrap(Vec::Constant(2, TypeParam(-1.0)))));
+}
+
 TYPED_TEST(TestTimeSeries, print_table)
 {
     std::stringstream output;
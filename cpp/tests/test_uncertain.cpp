@@ -26,6 +26,7 @@
 #include <gmock/gmock.h>
 
 #include <memory>
+#include <utility>
 
 TEST(TestUncertain, uncertain_value_basic)
 {
@@ -51,6 +52,27 @@ TEST(TestUncertain, uncertain_value_copy)
     check_distribution(*val.get_distribution().get(), *val2.get_distribution().get());
 }
 
+TEST(TestUncertain, uncertain_value_copy_on_write)
+{
+    mio::UncertainValue val(2.0);
+    val.set_distribution(mio::ParameterDistributionUniform(1.0, 3.0));
+
+    //copies share the distribution until it is modified
+    const mio::UncertainValue val2(val);
+    EXPECT_EQ(std::as_const(val).get_distribution().get(), val2.get_distribution().get());
+
+    val.get_distribution()->add_predefined_sample(2.5);
+    EXPECT_NE(std::as_const(val).get_distribution().get(), val2.get_distribution().get());
+    EXPECT_EQ(val.get_distribution()->get_predefined_samples().size(), 1);
+    EXPECT_EQ(val2.get_distribution()->get_predefined_samples().size(), 0);
+
+    //the distribution is not cloned again if it is not shared
+    auto dist = val.get_distribution().get();
+    val.draw_sample();
+    EXPECT_EQ(val, 2.5);
+    EXPECT_EQ(val.get_distribution().get(), dist);
+}
+
 TEST(TestUncertain, random_sample)
 {
     mio::UncertainValue val(2.0);
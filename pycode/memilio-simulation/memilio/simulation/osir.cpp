@@ -68,15 +68,15 @@ PYBIND11_MODULE(_simulation_osir, m)
         .def("check_constraints", &mio::osir::Parameters::check_constraints);
 
     using Populations = mio::Populations<mio::osir::InfectionState>;
-    pymio::bind_Population(m, "Population", mio::Tag<mio::osir::Model::Populations>{});
+    pymio::bind_Population(m, "Population", mio::Tag<mio::osir::Model<double>::Populations>{});
     pymio::bind_CompartmentalModel<mio::osir::InfectionState, Populations, mio::osir::Parameters>(m, "ModelBase");
-    py::class_<mio::osir::Model,
+    py::class_<mio::osir::Model<double>,
                mio::CompartmentalModel<mio::osir::InfectionState, Populations, mio::osir::Parameters>>(m, "Model")
         .def(py::init<>());
 
     m.def(
         "simulate",
-        [](double t0, double tmax, double dt, const mio::osir::Model& model) {
+        [](double t0, double tmax, double dt, const mio::osir::Model<double>& model) {
             return mio::simulate(t0, tmax, dt, model);
         },
         "Simulates a osir from t0 to tmax.", py::arg("t0"), py::arg("tmax"), py::arg("dt"), py::arg("model"));